@@ -24,13 +24,23 @@
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
 #include "PixelCoords.h"
 #include "PixelCoordsQueue.h"
 #include "PixelCoordsStack.h"
+#include "deflate.h"
 #include "instrumentation.h"
 
 // The data structure
@@ -44,8 +54,7 @@
 // which are pointers to the image structure, and should not access the
 // structure fields directly.
 
-// FIXED SIZE of LUT for storing RGB triplets
-#define FIXED_LUT_SIZE 1000
+// The FIXED SIZE of the LUT, FIXED_LUT_SIZE, is defined in imageRGB.h
 
 // Internal structure for storing RGB images
 struct image {
@@ -54,6 +63,10 @@ struct image {
   uint16** image;  // pointer to an array of pointers referencing the image rows
   uint16 num_colors;  // the number of colors (i.e., pixel labels) used
   rgb_t* LUT;         // table storing (R,G,B) triplets
+  struct image* parent;  // NULL, or the image whose pixels and LUT are
+                         // aliased by this view
+  void* mapping;         // NULL, or the loaded file the rows point into
+  size_t mapping_size;
 };
 
 // Design by Contract
@@ -132,6 +145,11 @@ static Image AllocateImageHeader(uint32 width, uint32 height) {
   newHeader->LUT[0] = 0xffffff;  // RGB WHITE
   newHeader->LUT[1] = 0x000000;  // RGB BLACK
 
+  // Not a view, rows not in a loaded file
+  newHeader->parent = NULL;
+  newHeader->mapping = NULL;
+  newHeader->mapping_size = 0;
+
   return newHeader;
 }
 
@@ -145,9 +163,18 @@ static uint16* AllocateRowArray(uint32 size) {
   return newArray;
 }
 
+/// A view shares the LUT of its parent, where new colors are allocated.
+/// Update the number of colors of a view, which may be outdated.
+static void LUTSync(Image img) {
+  if (img->parent != NULL) {
+    img->num_colors = img->parent->num_colors;
+  }
+}
+
 /// Find color label for given RGB color in img LUT.
 /// Return the label or -1 if not found.
 static int LUTFindColor(Image img, rgb_t color) {
+  LUTSync(img);
   for (uint16 index = 0; index < img->num_colors; index++) {
     if (img->LUT[index] == color) return index;
   }
@@ -162,15 +189,107 @@ static int LUTAllocColor(Image img, rgb_t color) {
     check(img->num_colors < FIXED_LUT_SIZE, "LUT Overflow");
     index = img->num_colors++;
     img->LUT[index] = color;
+    if (img->parent != NULL) {
+      img->parent->num_colors = img->num_colors;
+    }
   }
   return index;
 }
 
+// A hash map from RGB colors to labels, using open addressing and
+// linear probing. With more slots than twice the LUT size, it never
+// gets more than half full, and never needs to grow.
+#define COLOR_MAP_SIZE 2048
+#define COLOR_EMPTY UINT32_MAX  // never a valid (24-bit) color
+
+typedef struct {
+  rgb_t colors[COLOR_MAP_SIZE];
+  uint16 labels[COLOR_MAP_SIZE];
+} ColorMap;
+
+/// Return the slot of color in the map, or the empty slot where it goes.
+static uint32 ColorMapSlot(const ColorMap* map, rgb_t color) {
+  uint32 i = (color * 2654435761u) >> 21;  // 11 bits: COLOR_MAP_SIZE slots
+  while (map->colors[i] != COLOR_EMPTY && map->colors[i] != color) {
+    i = (i + 1) & (COLOR_MAP_SIZE - 1);
+  }
+  return i;
+}
+
+/// Fill the map with the colors of the img LUT.
+/// A repeated color keeps its first label, as in LUTFindColor.
+static void ColorMapInit(ColorMap* map, Image img) {
+  memset(map->colors, 0xff, sizeof(map->colors));  // all COLOR_EMPTY
+  LUTSync(img);
+  for (uint16 label = 0; label < img->num_colors; label++) {
+    uint32 i = ColorMapSlot(map, img->LUT[label]);
+    if (map->colors[i] == COLOR_EMPTY) {
+      map->colors[i] = img->LUT[label];
+      map->labels[i] = label;
+    }
+  }
+}
+
+/// Return the label of color, allocating a new label in the img LUT
+/// (and in the map) if the color is not found.
+static uint16 ColorMapAlloc(ColorMap* map, Image img, rgb_t color) {
+  uint32 i = ColorMapSlot(map, color);
+  if (map->colors[i] == color) return map->labels[i];
+  check(img->num_colors < FIXED_LUT_SIZE, "LUT Overflow");
+  uint16 label = img->num_colors++;
+  img->LUT[label] = color;
+  if (img->parent != NULL) {
+    img->parent->num_colors = img->num_colors;
+  }
+  map->colors[i] = color;
+  map->labels[i] = label;
+  return label;
+}
+
 /// Return a pseudo-random successor of the given color.
 static rgb_t GenerateNextColor(rgb_t color) {
   return (color + 7639) & 0xffffff;
 }
 
+// Load a whole file into memory: memory-mapped (copy-on-write), if
+// possible, or read into a new array. The size is stored in (*size).
+static void* MapFile(const char* filename, size_t* size) {
+#ifdef HAVE_MMAP
+  int fd = open(filename, O_RDONLY);
+  check(fd >= 0, "Open failed");
+  struct stat st;
+  check(fstat(fd, &st) == 0, "Stat failed");
+  *size = (size_t)st.st_size;
+  check(*size > 0, "Empty file");
+  void* data =
+      mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  check(data != MAP_FAILED, "Mapping failed");
+  close(fd);
+#else
+  FILE* f = NULL;
+  check((f = fopen(filename, "rb")) != NULL, "Open failed");
+  check(fseek(f, 0, SEEK_END) == 0, "Seek failed");
+  long length = ftell(f);
+  check(length > 0, "Empty file");
+  *size = (size_t)length;
+  rewind(f);
+  void* data = malloc(*size);
+  check(data != NULL, "Alloc file data");
+  check(fread(data, 1, *size, f) == *size, "Reading file failed");
+  fclose(f);
+#endif
+  return data;
+}
+
+static void UnmapFile(void* data, size_t size) {
+#ifdef HAVE_MMAP
+  munmap(data, size);
+#else
+  (void)size;
+  free(data);
+#endif
+}
+
 /// Image management functions
 
 /// Create a new RGB image. All pixels with the background WHITE color.
@@ -275,8 +394,21 @@ void ImageDestroy(Image* imgp) {
     return;
   }
 
-  for (uint32 i = 0; i < img->height; i++) {
-    free(img->image[i]);
+  if (img->parent != NULL) {
+    // A view: the pixels and the LUT belong to the parent
+    free(img->image);
+    free(img);
+    *imgp = NULL;
+    return;
+  }
+
+  if (img->mapping != NULL) {
+    // The rows are part of the loaded file
+    UnmapFile(img->mapping, img->mapping_size);
+  } else {
+    for (uint32 i = 0; i < img->height; i++) {
+      free(img->image[i]);
+    }
   }
   free(img->image);
   free(img->LUT);
@@ -293,6 +425,8 @@ void ImageDestroy(Image* imgp) {
 Image ImageCopy(const Image img) {
   assert(img != NULL);
 
+  LUTSync(img);
+
   // Cria cabeçalho e estruturas base
   Image copy = AllocateImageHeader(img->width, img->height);
 
@@ -314,12 +448,135 @@ Image ImageCopy(const Image img) {
   return copy;
 }
 
+/// Create a view of the rectangle of img with top-left corner (x, y),
+/// width w and height h.
+Image ImageView(const Image img, uint32 x, uint32 y, uint32 w, uint32 h) {
+  assert(img != NULL);
+  assert(w > 0);
+  assert(h > 0);
+  assert(x + w <= img->width);
+  assert(y + h <= img->height);
+
+  LUTSync(img);
+
+  Image view = malloc(sizeof(struct image));
+  check(view != NULL, "malloc");
+
+  view->width = w;
+  view->height = h;
+
+  // Only the array of pointers to rows is allocated:
+  // each row pointer references the parent row, shifted by x
+  view->image = malloc(h * sizeof(uint16*));
+  check(view->image != NULL, "Alloc failed ->image array");
+  for (uint32 i = 0; i < h; i++) {
+    view->image[i] = img->image[y + i] + x;
+  }
+
+  // A view of a view aliases the original image
+  view->parent = (img->parent != NULL) ? img->parent : img;
+  view->num_colors = img->num_colors;
+  view->LUT = img->LUT;
+  view->mapping = NULL;
+  view->mapping_size = 0;
+
+  return view;
+}
+
+/// Turn a view into an independent image, with its own copy of the
+/// pixels and the LUT. If img is not a view, nothing is done.
+void ImageMaterialize(Image img) {
+  assert(img != NULL);
+
+  if (img->parent == NULL) {
+    return;
+  }
+
+  LUTSync(img);
+
+  rgb_t* LUT = malloc(FIXED_LUT_SIZE * sizeof(rgb_t));
+  check(LUT != NULL, "Alloc failed ->LUT array");
+  memcpy(LUT, img->LUT, img->num_colors * sizeof(rgb_t));
+  img->LUT = LUT;
+
+  for (uint32 v = 0; v < img->height; v++) {
+    uint16* row = AllocateRowArray(img->width);
+    memcpy(row, img->image[v], img->width * sizeof(uint16));
+    PIXMEM += 2 * img->width;  // leituras + escritas
+    img->image[v] = row;
+  }
+
+  img->parent = NULL;
+}
+
+/// Paste the image src into the image dst, at column x and row y.
+void ImagePaste(Image dst, const Image src, uint32 x, uint32 y) {
+  assert(dst != NULL);
+  assert(src != NULL);
+  assert(dst != src);
+
+  if (x >= dst->width || y >= dst->height) {
+    return;  // Nothing to paste
+  }
+
+  LUTSync(src);
+
+  // Clip to dst
+  uint32 w = src->width;
+  uint32 h = src->height;
+  if (w > dst->width - x) w = dst->width - x;
+  if (h > dst->height - y) h = dst->height - y;
+
+  // The src labels used in the pasted rectangle
+  uint8 used[FIXED_LUT_SIZE];
+  memset(used, 0, src->num_colors);
+  for (uint32 v = 0; v < h; v++) {
+    const uint16* in = src->image[v];
+    for (uint32 u = 0; u < w; u++) {
+      used[in[u]] = 1;
+    }
+    PIXMEM += w;  // leituras
+  }
+
+  // Merge only their colors into the LUT of dst, once, looking them up
+  // in a hash map: remap[label of src] is the label of the same color in
+  // dst
+  ColorMap* map = malloc(sizeof(ColorMap));
+  check(map != NULL, "Alloc color map");
+  ColorMapInit(map, dst);
+  uint16 remap[FIXED_LUT_SIZE];
+  int identity = 1;
+  for (uint16 i = 0; i < src->num_colors; i++) {
+    if (used[i]) {
+      remap[i] = ColorMapAlloc(map, dst, src->LUT[i]);
+      identity = identity && (remap[i] == i);
+    }
+  }
+  free(map);
+
+  for (uint32 v = 0; v < h; v++) {
+    uint16* restrict out = dst->image[y + v] + x;
+    const uint16* restrict in = src->image[v];
+    if (identity) {
+      // Same labels: a plain copy of the row
+      memcpy(out, in, w * sizeof(uint16));
+    } else {
+      // Table lookup, without dependencies between pixels
+      for (uint32 u = 0; u < w; u++) {
+        out[u] = remap[in[u]];
+      }
+    }
+    PIXMEM += 2 * w;  // leituras + escritas
+  }
+}
+
 /// Printing on the console
 
 /// These functions do not modify the image and never fail.
 
 /// Output the raw RGB image (i.e., print the integer value of pixel).
 void ImageRAWPrint(const Image img) {
+  LUTSync(img);
   printf("width = %d height = %d\n", (int)img->width, (int)img->height);
   printf("num_colors = %d\n", (int)img->num_colors);
   printf("RAW image\n");
@@ -438,6 +695,7 @@ Image ImageLoadPBM(const char* filename) {  ///
 /// On failure, a partial and invalid file may be left in the system.
 int ImageSavePBM(const Image img, const char* filename) {  ///
   assert(img != NULL);
+  LUTSync(img);
   assert(img->num_colors == 2);
 
   int w = (int)img->width;
@@ -548,6 +806,452 @@ int ImageSavePPM(const Image img, const char* filename) {
   return 0;
 }
 
+/// PNG file operations --- For RGB images
+
+// See PNG format specification: https://www.w3.org/TR/png/
+
+// CRC-32 of a PNG chunk, as in the specification (table-driven)
+static uint32 PNGCrc(uint32 crc, const uint8* bytes, size_t n) {
+  static uint32 table[256];
+  static int table_ready = 0;
+  if (!table_ready) {
+    for (uint32 i = 0; i < 256; i++) {
+      uint32 c = i;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+      }
+      table[i] = c;
+    }
+    table_ready = 1;
+  }
+  for (size_t i = 0; i < n; i++) {
+    crc = table[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+static void PutUint32BE(uint8* bytes, uint32 value) {
+  bytes[0] = (uint8)(value >> 24);
+  bytes[1] = (uint8)(value >> 16);
+  bytes[2] = (uint8)(value >> 8);
+  bytes[3] = (uint8)value;
+}
+
+// Write a chunk: length, type, data and CRC (of type and data)
+static void WritePNGChunk(FILE* f, const char* type, const uint8* data,
+                          uint32 length) {
+  uint8 bytes[4];
+  PutUint32BE(bytes, length);
+  check(fwrite(bytes, 1, 4, f) == 4, "Writing chunk failed");
+  check(fwrite(type, 1, 4, f) == 4, "Writing chunk failed");
+  check(length == 0 || fwrite(data, 1, length, f) == length,
+        "Writing chunk failed");
+  uint32 crc = PNGCrc(0xffffffffu, (const uint8*)type, 4);
+  crc = PNGCrc(crc, data, length) ^ 0xffffffffu;
+  PutUint32BE(bytes, crc);
+  check(fwrite(bytes, 1, 4, f) == 4, "Writing chunk failed");
+}
+
+// The Paeth predictor of the PNG filter type 4
+static uint8 PaethPredictor(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = abs(p - a);
+  int pb = abs(p - b);
+  int pc = abs(p - c);
+  if (pa <= pb && pa <= pc) return (uint8)a;
+  if (pb <= pc) return (uint8)b;
+  return (uint8)c;
+}
+
+// Filter a row of n bytes (bpp bytes per pixel) with the given filter type.
+// prev is the previous (unfiltered) row, or NULL for the first row.
+static void FilterPNGRow(int type, const uint8* row, const uint8* prev,
+                         size_t n, int bpp, uint8* out) {
+  for (size_t i = 0; i < n; i++) {
+    int a = (i >= (size_t)bpp) ? row[i - bpp] : 0;
+    int b = (prev != NULL) ? prev[i] : 0;
+    int c = (prev != NULL && i >= (size_t)bpp) ? prev[i - bpp] : 0;
+    switch (type) {
+      case 0: out[i] = row[i]; break;
+      case 1: out[i] = (uint8)(row[i] - a); break;
+      case 2: out[i] = (uint8)(row[i] - b); break;
+      case 3: out[i] = (uint8)(row[i] - ((a + b) >> 1)); break;
+      default: out[i] = (uint8)(row[i] - PaethPredictor(a, b, c)); break;
+    }
+  }
+}
+
+/// Save image to a PNG file.
+/// On success, returns nonzero.
+/// On failure, a partial and invalid file may be left in the system.
+int ImageSavePNG(const Image img, const char* filename) {
+  assert(img != NULL);
+  assert(filename != NULL);
+
+  LUTSync(img);
+
+  uint32 W = img->width;
+  uint32 H = img->height;
+  int indexed = img->num_colors <= 256;
+  int bpp = indexed ? 1 : 3;  // bytes per pixel
+  size_t row_size = (size_t)W * bpp;
+
+  // The raw data: each row is preceded by its filter type byte
+  uint8* raw = malloc(H * (row_size + 1));
+  uint8* row = malloc(row_size);
+  uint8* prev = malloc(row_size);
+  uint8* trial = malloc(row_size);
+  check(raw != NULL && row != NULL && prev != NULL && trial != NULL,
+        "Alloc PNG buffers");
+
+  uint8* out = raw;
+  for (uint32 v = 0; v < H; v++) {
+    if (indexed) {
+      // Palette images compress best without filtering
+      for (uint32 u = 0; u < W; u++) row[u] = (uint8)img->image[v][u];
+      *out++ = 0;
+      memcpy(out, row, row_size);
+    } else {
+      for (uint32 u = 0; u < W; u++) {
+        rgb_t color = img->LUT[img->image[v][u]];
+        row[3 * u] = (uint8)(color >> 16);
+        row[3 * u + 1] = (uint8)(color >> 8);
+        row[3 * u + 2] = (uint8)color;
+      }
+      // Adaptive filtering: the type with the smallest sum of
+      // absolute (signed) differences
+      long best_sum = -1;
+      for (int type = 0; type <= 4; type++) {
+        FilterPNGRow(type, row, v > 0 ? prev : NULL, row_size, bpp, trial);
+        long sum = 0;
+        for (size_t i = 0; i < row_size; i++) sum += abs((int8_t)trial[i]);
+        if (best_sum < 0 || sum < best_sum) {
+          best_sum = sum;
+          out[0] = (uint8)type;
+          memcpy(out + 1, trial, row_size);
+        }
+      }
+      out++;
+      memcpy(prev, row, row_size);
+    }
+    out += row_size;
+    PIXMEM += W;  // leituras
+  }
+
+  size_t zsize;
+  uint8* zdata = ZlibCompress(raw, H * (row_size + 1), &zsize);
+  check(zsize <= 0x7fffffff, "PNG data too large");
+
+  FILE* f = NULL;
+  check((f = fopen(filename, "wb")) != NULL, "Open failed");
+
+  static const uint8 signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+  check(fwrite(signature, 1, 8, f) == 8, "Writing header failed");
+
+  uint8 ihdr[13];
+  PutUint32BE(ihdr, W);
+  PutUint32BE(ihdr + 4, H);
+  ihdr[8] = 8;                // bit depth
+  ihdr[9] = indexed ? 3 : 2;  // color type: indexed or RGB
+  ihdr[10] = 0;               // compression: deflate
+  ihdr[11] = 0;               // filter method: adaptive
+  ihdr[12] = 0;               // no interlace
+  WritePNGChunk(f, "IHDR", ihdr, 13);
+
+  if (indexed) {
+    uint8 plte[3 * 256];
+    for (uint16 i = 0; i < img->num_colors; i++) {
+      plte[3 * i] = (uint8)(img->LUT[i] >> 16);
+      plte[3 * i + 1] = (uint8)(img->LUT[i] >> 8);
+      plte[3 * i + 2] = (uint8)img->LUT[i];
+    }
+    WritePNGChunk(f, "PLTE", plte, 3 * (uint32)img->num_colors);
+  }
+
+  WritePNGChunk(f, "IDAT", zdata, (uint32)zsize);
+  WritePNGChunk(f, "IEND", NULL, 0);
+
+  // Cleanup
+  fclose(f);
+  free(zdata);
+  free(raw);
+  free(row);
+  free(prev);
+  free(trial);
+
+  return 1;
+}
+
+/// LUT file operations --- Native binary format
+
+#define LUT_MAGIC "LUTI"
+#define LUT_BYTE_ORDER 0x0102  // reads as 0x0201 in the other byte order
+#define LUT_FLAG_RLE 1
+#define LUT_ALIGN 64  // alignment of the pixel data and of each row
+
+// The LUT file header (32 bytes)
+typedef struct {
+  char magic[4];
+  uint16 byte_order;
+  uint16 depth;  // bits per label
+  uint32 width;
+  uint32 height;
+  uint32 num_colors;
+  uint32 flags;
+  uint32 data_offset;  // offset of the pixel data
+  uint32 row_stride;   // bytes between uncompressed rows
+} LUTFileHeader;
+
+static uint32 AlignUp(uint32 n) {
+  return (n + LUT_ALIGN - 1) / LUT_ALIGN * LUT_ALIGN;
+}
+
+static void WriteZeros(FILE* f, uint32 n) {
+  static const uint8 zeros[LUT_ALIGN] = {0};
+  check(fwrite(zeros, 1, n, f) == n, "Writing padding failed");
+}
+
+// Run-length encode a row, as (count, label) pairs.
+// Returns the number of uint16 values stored in runs (2 per run).
+static uint32 EncodeRowRLE(const uint16* row, uint32 width, uint16* runs) {
+  uint32 n = 0;
+  uint32 u = 0;
+  while (u < width) {
+    uint16 label = row[u];
+    uint32 count = 1;
+    while (u + count < width && row[u + count] == label && count < 0xffff) {
+      count++;
+    }
+    runs[n++] = (uint16)count;
+    runs[n++] = label;
+    u += count;
+  }
+  return n;
+}
+
+/// Save image to a LUT file.
+/// On success, returns nonzero.
+/// On failure, a partial and invalid file may be left in the system.
+int ImageSaveLUT(const Image img, const char* filename, int rle) {
+  assert(img != NULL);
+  assert(filename != NULL);
+
+  LUTSync(img);
+
+  LUTFileHeader header;
+  memcpy(header.magic, LUT_MAGIC, 4);
+  header.byte_order = LUT_BYTE_ORDER;
+  header.depth = 16;
+  header.width = img->width;
+  header.height = img->height;
+  header.num_colors = img->num_colors;
+  header.flags = rle ? LUT_FLAG_RLE : 0;
+  header.data_offset =
+      AlignUp(sizeof(LUTFileHeader) + img->num_colors * sizeof(rgb_t));
+  header.row_stride = rle ? 0 : AlignUp(img->width * sizeof(uint16));
+
+  FILE* f = NULL;
+  check((f = fopen(filename, "wb")) != NULL, "Open failed");
+  check(fwrite(&header, sizeof(header), 1, f) == 1, "Writing header failed");
+  check(fwrite(img->LUT, sizeof(rgb_t), img->num_colors, f) ==
+            img->num_colors,
+        "Writing LUT failed");
+  WriteZeros(f, header.data_offset - sizeof(LUTFileHeader) -
+                    img->num_colors * sizeof(rgb_t));
+
+  if (!rle) {
+    uint32 padding = header.row_stride - img->width * sizeof(uint16);
+    for (uint32 v = 0; v < img->height; v++) {
+      check(fwrite(img->image[v], sizeof(uint16), img->width, f) ==
+                img->width,
+            "Writing pixels failed");
+      WriteZeros(f, padding);
+      PIXMEM += img->width;  // leituras
+    }
+  } else {
+    // Encode all rows first, to write the index of row offsets
+    // (in bytes, from the end of the index) before the runs
+    uint16* runs = malloc((size_t)2 * img->width * img->height *
+                          sizeof(uint16));
+    uint32* offsets = malloc(((size_t)img->height + 1) * sizeof(uint32));
+    check(runs != NULL && offsets != NULL, "Alloc RLE buffers");
+
+    size_t n = 0;
+    for (uint32 v = 0; v < img->height; v++) {
+      offsets[v] = (uint32)(n * sizeof(uint16));
+      n += EncodeRowRLE(img->image[v], img->width, runs + n);
+      PIXMEM += img->width;  // leituras
+    }
+    offsets[img->height] = (uint32)(n * sizeof(uint16));
+
+    check(fwrite(offsets, sizeof(uint32), img->height + 1, f) ==
+              img->height + 1,
+          "Writing row index failed");
+    check(fwrite(runs, sizeof(uint16), n, f) == n, "Writing pixels failed");
+    free(runs);
+    free(offsets);
+  }
+
+  // Cleanup
+  fclose(f);
+
+  return 1;
+}
+
+/// Load a LUT file.
+/// On success, a new image is returned.
+/// (The caller is responsible for destroying the returned image!)
+Image ImageLoadLUT(const char* filename) {
+  assert(filename != NULL);
+
+  size_t size;
+  uint8* data = MapFile(filename, &size);
+
+  // Parse and validate the header
+  LUTFileHeader header;
+  check(size >= sizeof(header), "Invalid file format");
+  memcpy(&header, data, sizeof(header));
+  check(memcmp(header.magic, LUT_MAGIC, 4) == 0, "Invalid file format");
+  check(header.byte_order == LUT_BYTE_ORDER, "Invalid byte order");
+  check(header.depth == 16, "Invalid depth");
+  check(header.width > 0 && header.height > 0, "Invalid dimensions");
+  check(header.num_colors >= 2 && header.num_colors <= FIXED_LUT_SIZE,
+        "Invalid number of colors");
+  check(header.data_offset >=
+                sizeof(header) + header.num_colors * sizeof(rgb_t) &&
+            header.data_offset <= size,
+        "Invalid data offset");
+  // The pixel data is read in place, as uint32 (row index) and uint16
+  // values: reject offsets that would make those reads misaligned
+  check(header.data_offset % sizeof(uint32) == 0, "Invalid data offset");
+
+  Image img = AllocateImageHeader(header.width, header.height);
+  img->num_colors = (uint16)header.num_colors;
+  memcpy(img->LUT, data + sizeof(header), header.num_colors * sizeof(rgb_t));
+
+  const uint8* pixels = data + header.data_offset;
+  size_t pixels_size = size - header.data_offset;
+
+  if (!(header.flags & LUT_FLAG_RLE)) {
+    // The rows are used in place: no copying, no parsing
+    check(header.data_offset % LUT_ALIGN == 0, "Invalid data offset");
+    check(header.row_stride >= header.width * sizeof(uint16) &&
+              header.row_stride % sizeof(uint16) == 0 &&
+              pixels_size >= (size_t)header.row_stride * header.height,
+          "Invalid pixel data");
+    for (uint32 v = 0; v < header.height; v++) {
+      img->image[v] = (uint16*)(pixels + (size_t)v * header.row_stride);
+    }
+    img->mapping = data;
+    img->mapping_size = size;
+    return img;
+  }
+
+  // Decode the runs of each row
+  size_t index_size = ((size_t)header.height + 1) * sizeof(uint32);
+  check(pixels_size >= index_size, "Invalid row index");
+  const uint32* offsets = (const uint32*)pixels;
+  const uint8* runs = pixels + index_size;
+  size_t runs_size = pixels_size - index_size;
+
+  for (uint32 v = 0; v < header.height; v++) {
+    check(offsets[v] <= offsets[v + 1] && offsets[v + 1] <= runs_size &&
+              offsets[v] % sizeof(uint16) == 0 &&
+              offsets[v + 1] % sizeof(uint16) == 0,
+          "Invalid row index");
+    const uint16* run = (const uint16*)(runs + offsets[v]);
+    const uint16* end = (const uint16*)(runs + offsets[v + 1]);
+    uint16* row = AllocateRowArray(header.width);
+    uint32 u = 0;
+    for (; run + 1 < end; run += 2) {
+      check(run[0] <= header.width - u && run[1] < header.num_colors,
+            "Invalid run");
+      for (uint16 k = 0; k < run[0]; k++) row[u++] = run[1];
+    }
+    check(u == header.width, "Invalid row length");
+    img->image[v] = row;
+    PIXMEM += header.width;  // escritas
+  }
+
+  UnmapFile(data, size);
+  return img;
+}
+
+/// Packed RGB buffers --- For encoders and displays
+
+// Pixels are expanded in chunks: the LUT lookups of a chunk are done
+// first, into a small local array, and only then split into bytes.
+#define RGB_CHUNK 64
+
+// Expand the image colors into a packed buffer, with 3 (RGB) or
+// 4 (RGBA, opaque) bytes per pixel.
+static void ExpandToPacked(const Image img, uint8* buf, int bytes) {
+  assert(img != NULL);
+  assert(buf != NULL);
+  assert(bytes == 3 || bytes == 4);
+
+  rgb_t colors[RGB_CHUNK];
+  uint8* out = buf;
+
+  for (uint32 v = 0; v < img->height; v++) {
+    const uint16* row = img->image[v];
+    for (uint32 u0 = 0; u0 < img->width; u0 += RGB_CHUNK) {
+      uint32 n = img->width - u0;
+      if (n > RGB_CHUNK) n = RGB_CHUNK;
+      for (uint32 k = 0; k < n; k++) {
+        colors[k] = img->LUT[row[u0 + k]];
+      }
+      for (uint32 k = 0; k < n; k++) {
+        out[0] = (uint8)(colors[k] >> 16);
+        out[1] = (uint8)(colors[k] >> 8);
+        out[2] = (uint8)colors[k];
+        if (bytes == 4) out[3] = 0xff;
+        out += bytes;
+      }
+    }
+    PIXMEM += img->width;  // leituras
+  }
+}
+
+/// Expand the image colors into a packed RGB24 buffer.
+void ImageToRGB24(const Image img, uint8* buf) { ExpandToPacked(img, buf, 3); }
+
+/// Expand the image colors into a packed RGBA32 buffer.
+void ImageToRGBA32(const Image img, uint8* buf) {
+  ExpandToPacked(img, buf, 4);
+}
+
+/// Create an image from a packed RGB24 buffer.
+Image ImageFromRGB24(const uint8* buf, uint32 width, uint32 height) {
+  assert(buf != NULL);
+  assert(width > 0);
+  assert(height > 0);
+
+  Image img = ImageCreate(width, height);
+
+  // Starting with the fixed WHITE and BLACK labels
+  ColorMap* map = malloc(sizeof(ColorMap));
+  check(map != NULL, "Alloc color map");
+  ColorMapInit(map, img);
+
+  const uint8* in = buf;
+  for (uint32 v = 0; v < height; v++) {
+    uint16* row = img->image[v];
+    for (uint32 u = 0; u < width; u++) {
+      rgb_t color = (rgb_t)in[0] << 16 | (rgb_t)in[1] << 8 | in[2];
+      in += 3;
+      // Consecutive pixels often share the color: skip the lookup
+      row[u] = (u > 0 && color == img->LUT[row[u - 1]])
+                   ? row[u - 1]
+                   : ColorMapAlloc(map, img, color);
+    }
+    PIXMEM += width;  // escritas
+  }
+
+  free(map);
+  return img;
+}
+
 /// Information queries
 
 /// These functions do not modify the image and never fail.
@@ -567,9 +1271,109 @@ uint32 ImageHeight(const Image img) {
 /// Get number of image colors
 uint16 ImageColors(const Image img) {
   assert(img != NULL);
+  LUTSync(img);
   return img->num_colors;
 }
 
+/// Color usage statistics
+
+// Number of interleaved counter banks used by the histogram.
+// Consecutive pixels often have the same label (long runs of WHITE or
+// BLACK): with a single array, each increment would have to wait for the
+// previous store to the same counter. Spreading consecutive pixels over
+// independent banks lets those increments overlap.
+#define HIST_BANKS 4
+
+/// Count the pixels of each label (LUT index).
+///   counts: a caller-provided array of ImageColors(img) counters;
+///           counts[label] is set to the number of pixels with that label.
+void ImageHistogram(const Image img, uint32* counts) {
+  assert(img != NULL);
+  assert(counts != NULL);
+  LUTSync(img);
+
+  uint32 bank[HIST_BANKS][FIXED_LUT_SIZE] = {{0}};
+
+  uint32 W = img->width;
+  for (uint32 v = 0; v < img->height; v++) {
+    const uint16* row = img->image[v];
+    uint32 u = 0;
+    for (; u + HIST_BANKS <= W; u += HIST_BANKS) {
+      for (int b = 0; b < HIST_BANKS; b++) {
+        bank[b][row[u + b]]++;
+      }
+    }
+    for (; u < W; u++) {
+      bank[0][row[u]]++;
+    }
+    PIXMEM += W;  // leituras
+  }
+
+  // Juntar os bancos
+  for (uint16 label = 0; label < img->num_colors; label++) {
+    counts[label] = 0;
+    for (int b = 0; b < HIST_BANKS; b++) {
+      counts[label] += bank[b][label];
+    }
+  }
+}
+
+/// Get the number of LUT labels used by at least one pixel.
+uint16 ImageCountUsedColors(const Image img) {
+  assert(img != NULL);
+
+  uint32 counts[FIXED_LUT_SIZE];
+  ImageHistogram(img, counts);
+
+  uint16 used = 0;
+  for (uint16 label = 0; label < img->num_colors; label++) {
+    if (counts[label] > 0) used++;
+  }
+  return used;
+}
+
+/// Remove the unused entries from the LUT, relabeling the pixels.
+/// WHITE and BLACK keep their labels (0 and 1); the other used labels
+/// keep their relative order.
+/// Requires: img must not be a view.
+///
+/// Returns the new number of colors.
+uint16 ImageCompactLUT(Image img) {
+  assert(img != NULL);
+  assert(img->parent == NULL);  // a view cannot relabel its parent
+
+  uint32 counts[FIXED_LUT_SIZE];
+  ImageHistogram(img, counts);
+
+  // Nova posição de cada label usada; WHITE e BLACK ficam sempre
+  uint16 remap[FIXED_LUT_SIZE];
+  uint16 n = 0;
+  int identity = 1;
+  for (uint16 label = 0; label < img->num_colors; label++) {
+    if (label > BLACK && counts[label] == 0) continue;
+    remap[label] = n;
+    img->LUT[n] = img->LUT[label];
+    if (n != label) identity = 0;
+    n++;
+  }
+  img->num_colors = n;
+
+  if (identity) {
+    return n;  // só foram removidas entradas no fim da LUT
+  }
+
+  // Uma única passagem pela imagem para trocar as labels
+  for (uint32 v = 0; v < img->height; v++) {
+    uint16* row = img->image[v];
+    for (uint32 u = 0; u < img->width; u++) {
+      row[u] = remap[row[u]];
+    }
+    PIXMEM += 2 * img->width;  // leituras + escritas
+  }
+
+  return n;
+}
+
 /// Image comparison
 
 /// These functions do not modify the images and never fail.
@@ -618,14 +1422,10 @@ int ImageIsEqual(const Image img1, const Image img2) {
 /// On success, a new image is returned.
 /// (The caller is responsible for destroying the returned image!)
 
-/// Rotate 90 degrees clockwise (CW).
-/// Returns a rotated version of the image.
-/// Ensures: The original img is not modified.
-///
-/// On success, a new image is returned.
-/// (The caller is responsible for destroying the returned image!)
-Image ImageRotate90CW(const Image img) {
+// Imagem (ainda por preencher) com as dimensões trocadas e a LUT de img
+static Image AllocateRotated90(const Image img) {
   assert(img != NULL);
+  LUTSync(img);
 
   // Nova imagem com dimensões trocadas
   Image rotated = AllocateImageHeader(img->height, img->width);
@@ -641,6 +1441,58 @@ Image ImageRotate90CW(const Image img) {
     rotated->image[v] = AllocateRowArray(rotated->width);
   }
 
+  return rotated;
+}
+
+// Lado dos blocos percorridos pela rotação de 90 graus
+// (64 x 64 pixels de 16 bits = 8 KiB, cabe folgadamente na cache L1)
+#define ROTATE_TILE 64
+
+/// Rotate 90 degrees clockwise (CW).
+/// Returns a rotated version of the image.
+/// Ensures: The original img is not modified.
+///
+/// On success, a new image is returned.
+/// (The caller is responsible for destroying the returned image!)
+Image ImageRotate90CW(const Image img) {
+  Image rotated = AllocateRotated90(img);
+
+  // Mapeamento:
+  // original (r, c) -> novo (c, H-1-r)
+  uint32 H = img->height;
+  uint32 W = img->width;
+
+  // Percorre a imagem por blocos ROTATE_TILE x ROTATE_TILE: as colunas lidas
+  // de cada bloco e as linhas escritas cabem na cache, em vez de cada escrita
+  // cair numa linha diferente (e falhar a cache) em imagens largas.
+  for (uint32 r0 = 0; r0 < H; r0 += ROTATE_TILE) {
+    uint32 r1 = (H - r0 < ROTATE_TILE) ? H : r0 + ROTATE_TILE;
+    for (uint32 c0 = 0; c0 < W; c0 += ROTATE_TILE) {
+      uint32 c1 = (W - c0 < ROTATE_TILE) ? W : c0 + ROTATE_TILE;
+
+      for (uint32 c = c0; c < c1; c++) {
+        // Na prática é só trocar linha por coluna e espelhar
+        uint16* new_row = rotated->image[c];
+        for (uint32 r = r0; r < r1; r++) {
+          new_row[H - 1 - r] = img->image[r][c];
+        }
+      }
+      PIXMEM += 2 * (r1 - r0) * (c1 - c0);  // leituras + escritas
+    }
+  }
+
+  return rotated;
+}
+
+/// Rotate 90 degrees clockwise (CW), row by row.
+/// The same as ImageRotate90CW, without the blocks: each pixel read is
+/// written to a different row. Kept to compare the two traversals.
+///
+/// On success, a new image is returned.
+/// (The caller is responsible for destroying the returned image!)
+Image ImageRotate90CWRowMajor(const Image img) {
+  Image rotated = AllocateRotated90(img);
+
   // Mapeamento:
   // original (r, c) -> novo (c, H-1-r)
   uint32 H = img->height;
@@ -672,6 +1524,7 @@ Image ImageRotate90CW(const Image img) {
 /// (The caller is responsible for destroying the returned image!)
 Image ImageRotate180CW(const Image img) {
   assert(img != NULL);
+  LUTSync(img);
 
   // Mesmas dimensões
   Image rotated = AllocateImageHeader(img->width, img->height);
@@ -709,6 +1562,130 @@ Image ImageRotate180CW(const Image img) {
   return rotated;
 }
 
+/// Multi-resolution pyramid (thumbnails)
+
+// Half of a dimension, rounded up: odd sizes keep the last row or column
+static uint32 HalfSize(uint32 size) { return (size + 1) / 2; }
+
+// Downsample a label image: each pixel gets the mode of a 2x2 block
+static Image HalveLabels(const Image img) {
+  uint32 W = HalfSize(img->width);
+  uint32 H = HalfSize(img->height);
+
+  Image half = AllocateImageHeader(W, H);
+  half->num_colors = img->num_colors;
+  memcpy(half->LUT, img->LUT, img->num_colors * sizeof(rgb_t));
+
+  for (uint32 v = 0; v < H; v++) {
+    half->image[v] = AllocateRowArray(W);
+    const uint16* row0 = img->image[2 * v];
+    const uint16* row1 = (2 * v + 1 < img->height) ? img->image[2 * v + 1]
+                                                    : NULL;
+    for (uint32 u = 0; u < W; u++) {
+      // The (up to 4) labels of the block
+      uint16 block[4];
+      int n = 0;
+      block[n++] = row0[2 * u];
+      if (2 * u + 1 < img->width) block[n++] = row0[2 * u + 1];
+      if (row1 != NULL) {
+        block[n++] = row1[2 * u];
+        if (2 * u + 1 < img->width) block[n++] = row1[2 * u + 1];
+      }
+      PIXMEM += n;  // leituras
+
+      // The mode: the first label with the largest count
+      uint16 mode = block[0];
+      int best = 0;
+      for (int i = 0; i < n; i++) {
+        int count = 0;
+        for (int j = i; j < n; j++) count += (block[j] == block[i]);
+        if (count > best) {
+          best = count;
+          mode = block[i];
+        }
+      }
+      half->image[v][u] = mode;
+      PIXMEM++;  // escrita
+    }
+  }
+
+  return half;
+}
+
+/// Build a pyramid of label images.
+Image* ImageBuildPyramid(const Image img, int levels) {
+  assert(img != NULL);
+  assert(levels > 0);
+
+  LUTSync(img);
+
+  Image* pyramid = malloc(levels * sizeof(Image));
+  check(pyramid != NULL, "Alloc pyramid");
+
+  Image previous = img;
+  for (int k = 0; k < levels; k++) {
+    pyramid[k] = HalveLabels(previous);
+    previous = pyramid[k];
+  }
+
+  return pyramid;
+}
+
+// Downsample a packed RGB24 buffer: each pixel gets the average color
+// of a 2x2 block (of up to 4 pixels), rounded to the nearest
+static void HalveRGB24(const uint8* in, uint32 width, uint32 height,
+                       uint8* out) {
+  uint32 W = HalfSize(width);
+  uint32 H = HalfSize(height);
+
+  for (uint32 v = 0; v < H; v++) {
+    const uint8* row0 = in + (size_t)2 * v * width * 3;
+    const uint8* row1 = (2 * v + 1 < height) ? row0 + (size_t)width * 3
+                                              : row0;
+    for (uint32 u = 0; u < W; u++) {
+      uint32 u0 = 2 * u;
+      uint32 u1 = (u0 + 1 < width) ? u0 + 1 : u0;
+      // Repeating a missing row or column weighs the available pixels
+      for (int c = 0; c < 3; c++) {
+        uint32 sum = (uint32)row0[3 * u0 + c] + row0[3 * u1 + c] +
+                     row1[3 * u0 + c] + row1[3 * u1 + c];
+        *out++ = (uint8)((sum + 2) / 4);
+      }
+    }
+  }
+}
+
+/// Build a pyramid of packed RGB24 buffers.
+uint8** ImageBuildPyramidRGB24(const Image img, int levels) {
+  assert(img != NULL);
+  assert(levels > 0);
+
+  uint8** pyramid = malloc(levels * sizeof(uint8*));
+  check(pyramid != NULL, "Alloc pyramid");
+
+  // Level 0: the image colors, through the LUT
+  uint32 W = img->width;
+  uint32 H = img->height;
+  uint8* full = malloc((size_t)3 * W * H);
+  check(full != NULL, "Alloc RGB buffer");
+  ImageToRGB24(img, full);
+
+  const uint8* previous = full;
+  for (int k = 0; k < levels; k++) {
+    uint32 W2 = HalfSize(W);
+    uint32 H2 = HalfSize(H);
+    pyramid[k] = malloc((size_t)3 * W2 * H2);
+    check(pyramid[k] != NULL, "Alloc RGB buffer");
+    HalveRGB24(previous, W, H, pyramid[k]);
+    previous = pyramid[k];
+    W = W2;
+    H = H2;
+  }
+
+  free(full);
+  return pyramid;
+}
+
 
 /// Check whether pixel coords (u, v) are inside img.
 /// ATTENTION
@@ -840,46 +1817,65 @@ int ImageRegionFillingWithQUEUE(Image img, int u, int v, uint16 label) {
     return 0;
   }
 
+  // A fila guarda o índice linear v * W + u de cada pixel (4 bytes em vez de
+  // um Coord de 8): metade do tráfego de memória na fila, que para regiões
+  // grandes é o que domina o custo.
   size_t max = (size_t)W * (size_t)H;
-  Coord* queue = malloc(max * sizeof(Coord));
+  check(max <= UINT32_MAX, "Image too large for the queue");
+  uint32* queue = malloc(max * sizeof(uint32));
   check(queue != NULL, "Alloc queue");
 
   size_t head = 0;
   size_t tail = 0;
-  size_t size = 0;
   int count = 0;
-  // Implemento uma fila circular simples com os índices head/tail
 
   // Marca seed imediatamente
   img->image[v][u] = label;
   PIXMEM++;  // escrita
-  queue[tail++] = (Coord){u, v};
-  size++;
+  queue[tail++] = (uint32)v * W + (uint32)u;
   count++;
 
-  const int du[4] = {1, -1, 0, 0};
-  const int dv[4] = {0, 0, 1, -1};
-
-  while (size > 0) {
-    Coord p = queue[head++];
-    size--;
-    int x = p.u;
-    int y = p.v;
+  while (head < tail) {
+    uint32 p = queue[head++];
+    uint32 y = p / W;
+    uint32 x = p - y * W;
+    uint16* row = img->image[y];
 
-    for (int k = 0; k < 4; k++) {
-      int nx = x + du[k];
-      int ny = y + dv[k];
-
-      if (!ImageIsValidPixel(img, nx, ny)) {
-        continue;
+    // Vizinhos 4-conectados, pela mesma ordem de sempre: E, W, S, N.
+    // Os vizinhos horizontais estão na mesma linha (já em cache).
+    if (x + 1 < W) {
+      PIXMEM++;  // leitura
+      if (row[x + 1] == old_label) {
+        row[x + 1] = label;
+        PIXMEM++;  // escrita
+        queue[tail++] = p + 1;
+        count++;
       }
-
+    }
+    if (x > 0) {
       PIXMEM++;  // leitura
-      if (img->image[ny][nx] == old_label) {
-        img->image[ny][nx] = label;
+      if (row[x - 1] == old_label) {
+        row[x - 1] = label;
+        PIXMEM++;  // escrita
+        queue[tail++] = p - 1;
+        count++;
+      }
+    }
+    if (y + 1 < H) {
+      PIXMEM++;  // leitura
+      if (img->image[y + 1][x] == old_label) {
+        img->image[y + 1][x] = label;
         PIXMEM++;  // escrita
-        queue[tail++] = (Coord){nx, ny};
-        size++;
+        queue[tail++] = p + W;
+        count++;
+      }
+    }
+    if (y > 0) {
+      PIXMEM++;  // leitura
+      if (img->image[y - 1][x] == old_label) {
+        img->image[y - 1][x] = label;
+        PIXMEM++;  // escrita
+        queue[tail++] = p - W;
         count++;
       }
     }
@@ -948,3 +1944,373 @@ int ImageSegmentation(Image img, FillingFunction fillFunct) {
 
   return regions;
 }
+
+/// Distance Transform
+
+// Sentinel for "no BLACK pixel found yet" in the column pass
+#define DT_INFINITY UINT32_MAX
+
+// 1D squared distance transform of one row (Felzenszwalb & Huttenlocher).
+// f[j] is the squared vertical distance of column j, or DT_INFINITY.
+// Computes the lower envelope of the parabolas (j - q)^2 + f[q] and
+// stores its values in d.
+// Auxiliary arrays (of size n + 1): sites and boundaries of the envelope.
+static void DistanceTransformRow(uint32 n, const uint32* f, double* d,
+                                 uint32* sites, double* bounds) {
+  int k = -1;  // index of the rightmost parabola in the envelope
+
+  for (uint32 q = 0; q < n; q++) {
+    if (f[q] == DT_INFINITY) continue;  // no parabola for this column
+
+    double fq = (double)f[q] + (double)q * q;
+    double s = 0.0;
+    while (k >= 0) {
+      uint32 p = sites[k];
+      s = (fq - ((double)f[p] + (double)p * p)) / (2.0 * q - 2.0 * p);
+      if (s > bounds[k]) break;
+      k--;  // parabola p is hidden by parabola q
+    }
+    k++;
+    sites[k] = q;
+    bounds[k] = (k == 0) ? -1.0 : s;
+  }
+
+  if (k < 0) {
+    // No BLACK pixels in the whole image
+    for (uint32 q = 0; q < n; q++) d[q] = -1.0;
+    return;
+  }
+
+  int last = k;
+  k = 0;
+  for (uint32 q = 0; q < n; q++) {
+    while (k < last && bounds[k + 1] < (double)q) k++;
+    double dq = (double)q - (double)sites[k];
+    d[q] = dq * dq + (double)f[sites[k]];
+  }
+}
+
+/// Compute, for each pixel, the Euclidean distance to the nearest
+/// BLACK (contour) pixel.
+double* ImageDistanceTransform(const Image img) {
+  assert(img != NULL);
+
+  uint32 W = img->width;
+  uint32 H = img->height;
+
+  double* dist = malloc((size_t)W * H * sizeof(double));
+  check(dist != NULL, "Alloc distances");
+
+  // 1st pass: vertical distance of each pixel to the nearest BLACK pixel
+  // in its column. Two sweeps (down and up) over whole rows, so that the
+  // pixel array is always traversed in memory order.
+  uint32* g = malloc((size_t)W * H * sizeof(uint32));
+  check(g != NULL, "Alloc column distances");
+
+  for (uint32 v = 0; v < H; v++) {
+    uint32* g_row = g + (size_t)v * W;
+    const uint32* g_prev = (v > 0) ? g_row - W : NULL;
+    for (uint32 u = 0; u < W; u++) {
+      if (img->image[v][u] == BLACK) {
+        g_row[u] = 0;
+      } else if (g_prev == NULL || g_prev[u] == DT_INFINITY) {
+        g_row[u] = DT_INFINITY;
+      } else {
+        g_row[u] = g_prev[u] + 1;
+      }
+    }
+    PIXMEM += W;  // leituras
+  }
+  for (uint32 v = H - 1; v-- > 0;) {
+    uint32* g_row = g + (size_t)v * W;
+    const uint32* g_next = g_row + W;
+    for (uint32 u = 0; u < W; u++) {
+      if (g_next[u] != DT_INFINITY && g_next[u] + 1 < g_row[u]) {
+        g_row[u] = g_next[u] + 1;
+      }
+    }
+  }
+
+  // Squared vertical distances: the parabola heights for the 2nd pass
+  for (size_t i = 0; i < (size_t)W * H; i++) {
+    if (g[i] != DT_INFINITY) g[i] *= g[i];
+  }
+
+  // 2nd pass: exact 1D squared distance transform along each row
+  uint32* sites = malloc(((size_t)W + 1) * sizeof(uint32));
+  double* bounds = malloc(((size_t)W + 1) * sizeof(double));
+  check(sites != NULL && bounds != NULL, "Alloc envelope");
+
+  for (uint32 v = 0; v < H; v++) {
+    double* d_row = dist + (size_t)v * W;
+    DistanceTransformRow(W, g + (size_t)v * W, d_row, sites, bounds);
+    for (uint32 u = 0; u < W; u++) {
+      if (d_row[u] > 0.0) d_row[u] = sqrt(d_row[u]);
+    }
+  }
+
+  free(sites);
+  free(bounds);
+  free(g);
+
+  return dist;
+}
+
+/// Region Boundary Tracing
+
+// The 8 Moore neighbors, in clockwise order, starting at East
+// ATTENTION: the v axis points down
+static const int moore_du[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int moore_dv[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+// Direction index of the neighbor at offset (du, dv), with |du|, |dv| <= 1
+static int MooreDirection(int du, int dv) {
+  static const int dirs[3][3] = {{5, 4, 3}, {6, -1, 2}, {7, 0, 1}};
+  return dirs[du + 1][dv + 1];
+}
+
+static int IsRegionPixel(const Image img, int u, int v, uint16 label) {
+  if (!ImageIsValidPixel(img, u, v)) return 0;
+  PIXMEM++;  // leitura
+  return img->image[v][u] == label;
+}
+
+// Trace the contour through (u0, v0), entering it from the non-region
+// neighbor in direction back0 (Jacob's stopping criterion).
+// Stores the contour pixels in (*outline) if not NULL, growing the array.
+// Returns the number of contour pixels; also returns, through the
+// pointers, the contour length, twice its signed area (the shoelace
+// sum: positive for a clockwise contour, i.e., an outer contour) and
+// the column of the nearest contour pixel left of the start pixel, in its
+// row (-1 if none).
+static int MooreTrace(const Image img, int u0, int v0, uint16 label,
+                      int back0, PixelCoords** outline, double* length,
+                      long* area2, int* left) {
+  size_t capacity = 0;
+  int count = 0;
+  int axial = 0;
+  int diagonal = 0;
+  *area2 = 0;
+  *left = -1;
+
+  int pu = u0, pv = v0;
+  int back = back0;
+  int first_dir = -1;  // direction of the first move from the start pixel
+
+  for (;;) {
+    if (outline != NULL) {
+      if ((size_t)count == capacity) {
+        capacity = capacity ? 2 * capacity : 64;
+        *outline = realloc(*outline, capacity * sizeof(PixelCoords));
+        check(*outline != NULL, "Alloc outline");
+      }
+      (*outline)[count] = PixelCoordsCreate(pu, pv);
+    }
+    count++;
+    if (pv == v0 && pu < u0 && pu > *left) *left = pu;
+
+    // Sweep the neighbors clockwise, starting after the backtrack pixel
+    int d = -1;
+    for (int k = 1; k <= 8; k++) {
+      int dir = (back + k) % 8;
+      if (IsRegionPixel(img, pu + moore_du[dir], pv + moore_dv[dir], label)) {
+        d = dir;
+        break;
+      }
+    }
+    if (d < 0) break;  // an isolated pixel
+
+    if (pu == u0 && pv == v0) {
+      if (first_dir == d) break;  // same start move: the contour is closed
+      if (first_dir < 0) first_dir = d;
+    }
+
+    int qu = pu + moore_du[d];
+    int qv = pv + moore_dv[d];
+    (d % 2 == 0) ? axial++ : diagonal++;
+    *area2 += (long)pu * qv - (long)qu * pv;
+
+    // The new backtrack pixel is the last non-region neighbor swept
+    int prev = (d + 7) % 8;
+    back = MooreDirection(pu + moore_du[prev] - qu, pv + moore_dv[prev] - qv);
+    pu = qu;
+    pv = qv;
+  }
+
+  // The last move, back into the start pixel, was counted above
+  if (first_dir >= 0 && count > 1) count--;
+
+  *length = axial + diagonal * sqrt(2.0);
+  return count;
+}
+
+/// Trace the outer contour of the region containing the seed pixel (u, v).
+int ImageTraceRegionBoundary(const Image img, int u, int v,
+                             PixelCoords** outline, double* perimeter) {
+  assert(img != NULL);
+  assert(ImageIsValidPixel(img, u, v));
+
+  PIXMEM++;  // leitura seed
+  uint16 label = img->image[v][u];
+
+  PixelCoords* points = NULL;
+  double length = 0.0;
+  int count = 0;
+
+  // Walk left from the seed, to the first pixel with a non-region left
+  // neighbor. That pixel lies on a contour of the seed's region: if it is
+  // the contour of a hole (counterclockwise), cross the hole, to the
+  // nearest pixel of that contour on its left, and keep walking left.
+  // The pixels with the seed label inside the hole belong to other
+  // regions, and are crossed as well.
+  // Walking past the left border of the image ends on the outer contour.
+  int su = u;
+  for (;;) {
+    while (IsRegionPixel(img, su - 1, v, label)) su--;
+
+    long area2;
+    int left;
+    count = MooreTrace(img, su, v, label, 4, (outline ? &points : NULL),
+                       &length, &area2, &left);
+    if (area2 >= 0) break;  // clockwise: the outer contour
+
+    // A hole is closed on the left: there is always such a pixel, but
+    // stop at the hole contour, instead of failing, if there is none
+    if (left < 0) break;
+    su = left;
+  }
+
+  if (outline != NULL) {
+    *outline = points;
+  }
+  if (perimeter != NULL) {
+    *perimeter = length;
+  }
+  return count;
+}
+
+/// Region Adjacency
+
+// A hash set of label pairs, using open addressing and linear probing.
+// Each pair (a, b), with a < b, is stored as the key (a << 16 | b).
+#define PAIR_EMPTY UINT32_MAX  // never a valid key, since a < b
+
+typedef struct {
+  uint32* keys;
+  uint32 capacity;  // a power of 2
+  uint32 size;
+} PairSet;
+
+static void PairSetInit(PairSet* s, uint32 capacity) {
+  s->capacity = capacity;
+  s->size = 0;
+  s->keys = malloc(capacity * sizeof(uint32));
+  check(s->keys != NULL, "Alloc pair set");
+  memset(s->keys, 0xff, capacity * sizeof(uint32));  // all PAIR_EMPTY
+}
+
+static uint32 PairHash(uint32 key) {
+  // Multiplicative hashing (Knuth)
+  return key * 2654435761u;
+}
+
+static void PairSetInsert(PairSet* s, uint32 key);
+
+static void PairSetGrow(PairSet* s) {
+  uint32* old = s->keys;
+  uint32 old_capacity = s->capacity;
+  PairSetInit(s, 2 * old_capacity);
+  for (uint32 i = 0; i < old_capacity; i++) {
+    if (old[i] != PAIR_EMPTY) PairSetInsert(s, old[i]);
+  }
+  free(old);
+}
+
+static void PairSetInsert(PairSet* s, uint32 key) {
+  uint32 mask = s->capacity - 1;
+  uint32 i = PairHash(key) & mask;
+  while (s->keys[i] != PAIR_EMPTY) {
+    if (s->keys[i] == key) return;  // already there
+    i = (i + 1) & mask;
+  }
+  s->keys[i] = key;
+  s->size++;
+  // Keep the load factor below 1/2
+  if (2 * s->size > s->capacity) PairSetGrow(s);
+}
+
+// Insert the pair of labels a and b, if both are regions and different.
+// The most recent key is cached: along a contour, the same pair repeats.
+static void AddRegionPair(PairSet* s, uint32* last, uint16 a, uint16 b) {
+  if (a == b || a == BLACK || b == BLACK) return;
+  uint32 key = (a < b) ? ((uint32)a << 16 | b) : ((uint32)b << 16 | a);
+  if (key == *last) return;
+  *last = key;
+  PairSetInsert(s, key);
+}
+
+/// Find the pairs of regions of a segmented image that touch each other.
+int ImageRegionAdjacencies(const Image img, uint8* used, uint16** pairs) {
+  assert(img != NULL);
+  assert(pairs != NULL);
+
+  uint32 W = img->width;
+  uint32 H = img->height;
+
+  LUTSync(img);
+  if (used != NULL) {
+    memset(used, 0, img->num_colors * sizeof(uint8));
+  }
+
+  PairSet set;
+  PairSetInit(&set, 64);
+  uint32 last = PAIR_EMPTY;
+
+  for (uint32 v = 0; v < H; v++) {
+    const uint16* row = img->image[v];
+    const uint16* above = (v > 0) ? img->image[v - 1] : NULL;
+    const uint16* below = (v + 1 < H) ? img->image[v + 1] : NULL;
+    PIXMEM += W;  // leituras
+
+    for (uint32 u = 0; u < W; u++) {
+      uint16 label = row[u];
+
+      if (label != BLACK) {
+        if (used != NULL) used[label] = 1;
+        // Regions touching directly: right and down neighbors
+        if (u + 1 < W) AddRegionPair(&set, &last, label, row[u + 1]);
+        if (below != NULL) AddRegionPair(&set, &last, label, below[u]);
+        continue;
+      }
+
+      // A contour pixel: the regions around it touch across it
+      uint16 around[4];
+      int n = 0;
+      if (u > 0) around[n++] = row[u - 1];
+      if (u + 1 < W) around[n++] = row[u + 1];
+      if (above != NULL) around[n++] = above[u];
+      if (below != NULL) around[n++] = below[u];
+      for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+          AddRegionPair(&set, &last, around[i], around[j]);
+        }
+      }
+    }
+  }
+
+  // Gather the distinct pairs
+  uint16* result = malloc((2 * (size_t)set.size + 1) * sizeof(uint16));
+  check(result != NULL, "Alloc pairs");
+  uint32 k = 0;
+  for (uint32 i = 0; i < set.capacity; i++) {
+    if (set.keys[i] != PAIR_EMPTY) {
+      result[k++] = (uint16)(set.keys[i] >> 16);
+      result[k++] = (uint16)(set.keys[i] & 0xffff);
+    }
+  }
+  int count = (int)set.size;
+  free(set.keys);
+
+  *pairs = result;
+  return count;
+}
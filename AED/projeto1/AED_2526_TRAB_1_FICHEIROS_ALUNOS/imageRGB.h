@@ -15,6 +15,8 @@
 
 #include <inttypes.h>
 
+#include "PixelCoords.h"
+
 // Types for non-negative integer values
 typedef uint8_t uint8;
 typedef uint16_t uint16;
@@ -32,6 +34,10 @@ typedef struct image* Image;
 #define WHITE 0  // White pixel label (i.e., LUT index)
 #define BLACK 1  // Black pixel label
 
+// FIXED SIZE of LUT for storing RGB triplets:
+// an image has at most FIXED_LUT_SIZE colors (labels)
+#define FIXED_LUT_SIZE 1000
+
 /// Init Image library.  (Call once!)
 /// Currently, simply calibrate instrumentation and set names of counters.
 void ImageInit(void);
@@ -74,6 +80,33 @@ void ImageDestroy(Image* imgp);
 /// (The caller is responsible for destroying the returned image!)
 Image ImageCopy(const Image img);
 
+/// Create a view of a rectangular part of the image pointed to by img:
+/// an image that aliases the pixels and the LUT of img, without copying.
+///   x, y: the column and row of the top-left corner of the rectangle.
+///   w, h: the width and height of the rectangle.
+/// Requires: the rectangle must be inside img.
+///
+/// A view can be used as any other image: changes to its pixels are
+/// changes to the pixels of img, and new colors are allocated in the LUT
+/// of img. The original image must not be destroyed before its views.
+///
+/// On success, a new view is returned.
+/// (The caller is responsible for destroying the returned view!)
+Image ImageView(const Image img, uint32 x, uint32 y, uint32 w, uint32 h);
+
+/// Turn the view pointed to by img into an independent image,
+/// with a deep copy of its pixels and LUT.
+/// If img is not a view, no operation is performed.
+void ImageMaterialize(Image img);
+
+/// Paste the image src into the image dst, with the top-left corner of
+/// src at column x and row y of dst.
+/// The parts of src outside dst are clipped.
+/// The colors of the pasted pixels of src are merged into the LUT of dst,
+/// once per call, and the src labels are translated to the dst labels.
+/// Requires: dst and src must not share pixels (e.g., overlapping views).
+void ImagePaste(Image dst, const Image src, uint32 x, uint32 y);
+
 /// Printing on the console
 
 /// These functions do not modify the image and never fail.
@@ -107,6 +140,62 @@ Image ImageLoadPPM(const char* filename);
 /// On failure, a partial and invalid file may be left in the system.
 int ImageSavePPM(const Image img, const char* filename);
 
+/// PNG file operations --- For RGB images
+
+/// Save image to a PNG file.
+/// Images with up to 256 colors are saved in indexed-color mode,
+/// with the LUT as the palette; others are saved in RGB mode.
+/// The pixel data is compressed with the deflate module.
+/// On success, returns nonzero.
+/// On failure, a partial and invalid file may be left in the system.
+int ImageSavePNG(const Image img, const char* filename);
+
+/// LUT file operations --- Native binary format
+
+/// A LUT file stores the image LUT and the pixel labels as they are
+/// in memory (native byte order):
+///   a 32-byte header (magic "LUTI", byte order mark, label depth,
+///   width, height, number of colors, flags, offset of the pixel data
+///   and row stride), followed by the LUT and the pixel data.
+/// The pixel data is either the label rows, each one starting at a
+/// 64-byte aligned offset, or, if compressed, an index of row offsets
+/// followed by the (count, label) runs of each row.
+
+/// Save image to a LUT file.
+///   rle: if nonzero, compress each row with run-length encoding.
+/// On success, returns nonzero.
+/// On failure, a partial and invalid file may be left in the system.
+int ImageSaveLUT(const Image img, const char* filename, int rle);
+
+/// Load a LUT file.
+/// Uncompressed files are memory-mapped: the image rows reference the
+/// mapped file, without copying or parsing. Changes to the pixels
+/// are private, and never written back to the file.
+/// On success, a new image is returned.
+/// (The caller is responsible for destroying the returned image!)
+Image ImageLoadLUT(const char* filename);
+
+/// Packed RGB buffers --- For encoders and displays
+
+/// Expand the image colors into a packed RGB24 buffer:
+/// 3 bytes (R, G, B) per pixel, rows stored consecutively, top to bottom.
+///   buf: a caller-provided buffer of (3 * width * height) bytes.
+void ImageToRGB24(const Image img, uint8* buf);
+
+/// Expand the image colors into a packed RGBA32 buffer:
+/// 4 bytes (R, G, B, A) per pixel, with A = 255 (opaque).
+///   buf: a caller-provided buffer of (4 * width * height) bytes.
+void ImageToRGBA32(const Image img, uint8* buf);
+
+/// Create an image from a packed RGB24 buffer (as above).
+/// Labels are assigned to the colors in order of first appearance,
+/// after the WHITE and BLACK labels.
+/// Requires: width and height must be positive.
+///
+/// On success, a new image is returned.
+/// (The caller is responsible for destroying the returned image!)
+Image ImageFromRGB24(const uint8* buf, uint32 width, uint32 height);
+
 /// Information queries
 
 /// These functions do not modify the image and never fail.
@@ -120,6 +209,25 @@ uint32 ImageHeight(const Image img);
 /// Get number of image colors
 uint16 ImageColors(const Image img);
 
+/// Color usage statistics
+
+/// Count the pixels of each label (LUT index).
+///   counts: a caller-provided array of ImageColors(img) counters
+///           (FIXED_LUT_SIZE are always enough);
+///           counts[label] is set to the number of pixels with that label.
+void ImageHistogram(const Image img, uint32* counts);
+
+/// Get the number of LUT labels used by at least one pixel.
+uint16 ImageCountUsedColors(const Image img);
+
+/// Remove the unused entries from the LUT, relabeling the pixels.
+/// WHITE and BLACK keep their labels (0 and 1); the other used labels
+/// keep their relative order.
+/// Requires: img must not be a view.
+///
+/// Returns the new number of colors.
+uint16 ImageCompactLUT(Image img);
+
 /// Image comparison
 
 /// These functions do not modify the images and never fail.
@@ -147,6 +255,14 @@ int ImageIsDifferent(const Image img1, const Image img2);
 /// (The caller is responsible for destroying the returned image!)
 Image ImageRotate90CW(const Image img);
 
+/// Rotate 90 degrees clockwise (CW), row by row.
+/// The same as ImageRotate90CW, without its cache-friendly blocks:
+/// kept to compare the two traversals.
+///
+/// On success, a new image is returned.
+/// (The caller is responsible for destroying the returned image!)
+Image ImageRotate90CWRowMajor(const Image img);
+
 /// Rotate 180 degrees clockwise (CW).
 /// Returns a rotated version of the image.
 /// Ensures: The original img is not modified.
@@ -155,6 +271,35 @@ Image ImageRotate90CW(const Image img);
 /// (The caller is responsible for destroying the returned image!)
 Image ImageRotate180CW(const Image img);
 
+/// Multi-resolution pyramid (thumbnails)
+
+/// Downsample the image, halving its dimensions (rounded up) at each of
+/// the given number of levels. Each level is computed from the previous
+/// one: the total cost is about 4/3 of a pass over the image.
+
+/// Build a pyramid of label images.
+/// Each pixel gets the most frequent label (the mode) of the
+/// corresponding 2x2 block of the previous level; ties are broken
+/// in favor of the first label in row-major order.
+/// The images share no data with img, and keep its LUT.
+/// Requires: levels must be positive.
+///
+/// Returns an array of levels images: the k-th image (k = 0, 1, ...)
+/// has 1/2^(k+1) of the dimensions of img.
+/// (The caller is responsible for destroying the returned images
+/// and freeing the returned array!)
+Image* ImageBuildPyramid(const Image img, int levels);
+
+/// Build a pyramid of packed RGB24 buffers (see ImageToRGB24).
+/// Each pixel gets the average RGB color of the corresponding 2x2 block
+/// of the previous level, looked up through the LUT.
+/// Requires: levels must be positive.
+///
+/// Returns an array of levels buffers, with the dimensions above.
+/// (The caller is responsible for freeing the returned buffers
+/// and the returned array!)
+uint8** ImageBuildPyramidRGB24(const Image img, int levels);
+
 /// Check whether pixel coords (u, v) are inside img.
 /// ATTENTION
 ///   u : column index
@@ -203,4 +348,55 @@ typedef int (*FillingFunction)(Image img, int u, int v, uint16 label);
 /// Returns the number of image regions found.
 int ImageSegmentation(Image img, FillingFunction fillFunct);
 
+/// Distance Transform
+
+/// Compute, for each pixel, the Euclidean distance to the nearest
+/// BLACK (contour) pixel.
+/// Uses a separable two-pass algorithm (columns, then rows), with
+/// O(width * height) time.
+///
+/// Returns an array of (width * height) distances, in row-major order:
+/// the distance of pixel (u, v) is stored at index (v * width + u).
+/// BLACK pixels have distance 0.0.
+/// If the image has no BLACK pixels, all distances are -1.0.
+/// (The caller is responsible for freeing the returned array!)
+double* ImageDistanceTransform(const Image img);
+
+/// Region Boundary Tracing
+
+/// Trace the outer contour of the region containing the seed pixel (u, v),
+/// using the Moore-neighbor tracing algorithm.
+/// The region is the set of 8-connected pixels with the seed label;
+/// other pixels with that label, even inside its holes, are not part of it.
+///   img: the image (not modified).
+///   u, v: the coordinates of the seed pixel.
+///   outline: if not NULL, (*outline) is set to a new array with the
+///     coordinates of the contour pixels, in clockwise order.
+///     (The caller is responsible for freeing the returned array!)
+///   perimeter: if not NULL, (*perimeter) is set to the length of the
+///     closed contour (1 for each axial step, sqrt(2) for each diagonal).
+///
+/// The cost is proportional to the length of the contours met left of the
+/// seed, in its row (the outer one and those of the holes), not the area.
+/// Returns the number of contour pixels.
+int ImageTraceRegionBoundary(const Image img, int u, int v,
+                             PixelCoords** outline, double* perimeter);
+
+/// Region Adjacency
+
+/// Find the pairs of regions of a segmented image that touch each other,
+/// either directly or across a BLACK contour pixel (4-neighbors).
+/// Uses a single raster pass, with a hash set to discard repeated pairs.
+///   img: the image (not modified).
+///   used: if not NULL, an array of ImageColors(img) flags;
+///     used[label] is set to 1 for each label present in the image,
+///     and to 0 otherwise.
+///   pairs: (*pairs) is set to a new array storing the distinct pairs,
+///     two labels per pair, the smaller label first.
+///     BLACK is never part of a pair.
+///     (The caller is responsible for freeing the returned array!)
+///
+/// Returns the number of distinct pairs.
+int ImageRegionAdjacencies(const Image img, uint8* used, uint16** pairs);
+
 #endif
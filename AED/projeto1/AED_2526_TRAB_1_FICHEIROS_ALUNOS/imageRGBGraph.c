@@ -0,0 +1,51 @@
+/// imageRGBGraph - Building graphs from segmented imageRGB images,
+///                 using the Graph module of the second project
+///
+/// This module is part of a programming project
+/// for the course AED, DETI / UA.PT
+///
+/// You may freely use and modify this code, at your own risk,
+/// as long as you give proper credit to the original and subsequent authors.
+///
+/// The AED Team <jmadeira@ua.pt, jmr@ua.pt, ...>
+/// 2025
+
+#include "imageRGBGraph.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Graph.h"
+#include "imageRGB.h"
+
+/// Build the region adjacency graph of a segmented image.
+Graph* ImageBuildRegionAdjacencyGraph(const Image img) {
+  assert(img != NULL);
+
+  uint16 num_colors = ImageColors(img);
+
+  // A single raster pass finds the labels used and the distinct pairs,
+  // so GraphAddEdge is called once per pair of adjacent regions
+  uint8* used = malloc(num_colors * sizeof(uint8));
+  if (used == NULL) abort();
+  uint16* pairs = NULL;
+  int num_pairs = ImageRegionAdjacencies(img, used, &pairs);
+
+  Graph* g = GraphCreateEmpty(num_colors, 0, 0);
+
+  for (uint16 label = 0; label < num_colors; label++) {
+    if (used[label] && label != BLACK) {
+      GraphAddVertex(g, label);
+    }
+  }
+
+  for (int i = 0; i < num_pairs; i++) {
+    GraphAddEdge(g, pairs[2 * i], pairs[2 * i + 1]);
+  }
+
+  free(pairs);
+  free(used);
+
+  return g;
+}
@@ -0,0 +1,47 @@
+// imageRGBGraphTest - Region adjacency graphs of segmented images.
+//
+// This program is an example use of the imageRGBGraph module,
+// joining the imageRGB module and the Graph module of the second project.
+//
+// You may freely use and modify this code, NO WARRANTY, blah blah,
+// as long as you give proper credit to the original and subsequent authors.
+//
+// The AED Team <jmadeira@ua.pt, jmr@ua.pt, ...>
+// 2025
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Graph.h"
+#include "error.h"
+#include "imageRGB.h"
+#include "imageRGBGraph.h"
+
+int main(int argc, char* argv[]) {
+  program_name = argv[0];
+  if (argc != 1) {
+    error(1, 0, "Usage: imageRGBGraphTest");
+  }
+
+  ImageInit();
+
+  printf("1) ImageCreateChess + ImageSegmentation\n");
+  // 3 x 3 pixels: 4 white pixels, separated by 1-pixel black contours
+  Image image_chess = ImageCreateChess(3, 3, 1, 0x000000);
+  int regions = ImageSegmentation(image_chess, ImageRegionFillingWithQUEUE);
+  printf("Regions = %d\n", regions);
+
+  printf("2) ImageBuildRegionAdjacencyGraph\n");
+  Graph* g = ImageBuildRegionAdjacencyGraph(image_chess);
+  GraphCheckInvariants(g);
+  GraphDisplayDOT(g);
+  // The 4 regions touch each other across the central black pixel
+  assert(GraphGetNumVertices(g) == (unsigned int)regions);
+  assert(GraphGetNumEdges(g) == 6);
+
+  GraphDestroy(&g);
+  ImageDestroy(&image_chess);
+
+  return 0;
+}
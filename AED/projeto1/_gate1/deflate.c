@@ -0,0 +1,226 @@
+/// deflate - A small, dependency-free zlib (RFC 1950) compressor,
+///           using the DEFLATE format (RFC 1951) with fixed Huffman codes
+///           and an LZ77 matcher based on hash chains
+///
+/// This module is part of a programming project
+/// for the course AED, DETI / UA.PT
+///
+/// You may freely use and modify this code, at your own risk,
+/// as long as you give proper credit to the original and subsequent authors.
+///
+/// The AED Team <jmadeira@ua.pt, jmr@ua.pt, ...>
+/// 2025
+
+#include "deflate.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+// LZ77 parameters
+#define WINDOW_SIZE 32768  // maximum match distance
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define MAX_CHAIN 32  // maximum number of candidates tried per position
+#define HASH_BITS 15
+#define HASH_SIZE (1 << HASH_BITS)
+
+// The lengths 3..258 are coded as a symbol 257..285 plus extra bits
+static const uint16_t length_base[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                         1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                         4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+// The distances 1..32768 are coded as a symbol 0..29 plus extra bits
+static const uint16_t dist_base[30] = {
+    1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,
+    97,  129, 193, 257, 385, 513,  769,  1025, 1537, 2049, 3073, 4097,
+    6145, 8193, 12289, 16385, 24577};
+static const uint8_t dist_extra[30] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,
+                                       4, 4, 5, 5, 6, 6, 7,  7,  8,  8,
+                                       9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// A growable output buffer, written bit by bit (LSB first)
+typedef struct {
+  uint8_t* data;
+  size_t size;
+  size_t capacity;
+  uint32_t bits;  // pending bits, not yet written
+  int num_bits;   // number of pending bits
+} BitWriter;
+
+static void PutByte(BitWriter* w, uint8_t byte) {
+  if (w->size == w->capacity) {
+    w->capacity = 2 * w->capacity;
+    w->data = realloc(w->data, w->capacity);
+    if (w->data == NULL) abort();
+  }
+  w->data[w->size++] = byte;
+}
+
+static void PutBits(BitWriter* w, uint32_t value, int n) {
+  w->bits |= value << w->num_bits;
+  w->num_bits += n;
+  while (w->num_bits >= 8) {
+    PutByte(w, (uint8_t)w->bits);
+    w->bits >>= 8;
+    w->num_bits -= 8;
+  }
+}
+
+// Huffman codes are sent starting from their most significant bit
+static void PutCode(BitWriter* w, uint32_t code, int n) {
+  uint32_t reversed = 0;
+  for (int i = 0; i < n; i++) {
+    reversed = (reversed << 1) | ((code >> i) & 1);
+  }
+  PutBits(w, reversed, n);
+}
+
+static void FlushBits(BitWriter* w) {
+  if (w->num_bits > 0) {
+    PutByte(w, (uint8_t)w->bits);
+  }
+  w->bits = 0;
+  w->num_bits = 0;
+}
+
+// Write a literal/length symbol, using the fixed Huffman code
+static void PutLitLen(BitWriter* w, int symbol) {
+  if (symbol < 144) {
+    PutCode(w, 0x30 + symbol, 8);
+  } else if (symbol < 256) {
+    PutCode(w, 0x190 + (symbol - 144), 9);
+  } else if (symbol < 280) {
+    PutCode(w, symbol - 256, 7);
+  } else {
+    PutCode(w, 0xc0 + (symbol - 280), 8);
+  }
+}
+
+static void PutMatch(BitWriter* w, int length, int distance) {
+  int i = 28;
+  while (length_base[i] > length) i--;
+  PutLitLen(w, 257 + i);
+  PutBits(w, length - length_base[i], length_extra[i]);
+
+  int j = 29;
+  while (dist_base[j] > distance) j--;
+  PutCode(w, j, 5);  // fixed distance codes: 5 bits
+  PutBits(w, distance - dist_base[j], dist_extra[j]);
+}
+
+static uint32_t Hash3(const uint8_t* p) {
+  uint32_t v = (uint32_t)p[0] << 16 | (uint32_t)p[1] << 8 | p[2];
+  return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static uint32_t Adler32(const uint8_t* data, size_t size) {
+  uint32_t a = 1;
+  uint32_t b = 0;
+  while (size > 0) {
+    // Largest block before the sums may overflow 32 bits
+    size_t n = size < 5552 ? size : 5552;
+    size -= n;
+    while (n-- > 0) {
+      a += *data++;
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+  return b << 16 | a;
+}
+
+/// Compress size bytes of data into a zlib stream.
+uint8_t* ZlibCompress(const uint8_t* data, size_t size, size_t* out_size) {
+  assert(data != NULL || size == 0);
+  assert(out_size != NULL);
+
+  BitWriter w;
+  w.capacity = size / 2 + 64;
+  w.data = malloc(w.capacity);
+  if (w.data == NULL) abort();
+  w.size = 0;
+  w.bits = 0;
+  w.num_bits = 0;
+
+  // zlib header: deflate, 32K window, no dictionary, fastest level
+  PutByte(&w, 0x78);
+  PutByte(&w, 0x01);
+
+  // A single, final block with the fixed Huffman codes
+  PutBits(&w, 1, 1);  // BFINAL
+  PutBits(&w, 1, 2);  // BTYPE = 01
+
+  // Hash chains: head[h] is the last position with hash h,
+  // prev[pos % WINDOW_SIZE] the previous position with the same hash
+  int32_t* head = malloc(HASH_SIZE * sizeof(int32_t));
+  int32_t* prev = malloc(WINDOW_SIZE * sizeof(int32_t));
+  if (head == NULL || prev == NULL) abort();
+  for (int i = 0; i < HASH_SIZE; i++) head[i] = -1;
+
+  size_t pos = 0;
+  while (pos < size) {
+    int best_length = 0;
+    int best_distance = 0;
+
+    if (pos + MIN_MATCH <= size) {
+      uint32_t h = Hash3(data + pos);
+      size_t max_length = size - pos < MAX_MATCH ? size - pos : MAX_MATCH;
+
+      int32_t candidate = head[h];
+      for (int chain = 0; candidate >= 0 && chain < MAX_CHAIN; chain++) {
+        size_t distance = pos - (size_t)candidate;
+        if (distance > WINDOW_SIZE) break;
+        const uint8_t* p = data + candidate;
+        const uint8_t* q = data + pos;
+        if (p[best_length] == q[best_length]) {
+          size_t length = 0;
+          while (length < max_length && p[length] == q[length]) length++;
+          if ((int)length > best_length) {
+            best_length = (int)length;
+            best_distance = (int)distance;
+            if (length == max_length) break;
+          }
+        }
+        candidate = prev[candidate % WINDOW_SIZE];
+      }
+    }
+
+    int advance = 1;
+    if (best_length >= MIN_MATCH) {
+      PutMatch(&w, best_length, best_distance);
+      advance = best_length;
+    } else {
+      PutLitLen(&w, data[pos]);
+    }
+
+    // Insert the positions consumed into the hash chains
+    for (int i = 0; i < advance; i++, pos++) {
+      if (pos + MIN_MATCH <= size) {
+        uint32_t h = Hash3(data + pos);
+        prev[pos % WINDOW_SIZE] = head[h];
+        head[h] = (int32_t)pos;
+      }
+    }
+  }
+
+  PutLitLen(&w, 256);  // end of block
+  FlushBits(&w);
+
+  free(head);
+  free(prev);
+
+  // zlib trailer: Adler-32 checksum of the data, big-endian
+  uint32_t adler = Adler32(data, size);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    PutByte(&w, (uint8_t)(adler >> shift));
+  }
+
+  *out_size = w.size;
+  return w.data;
+}
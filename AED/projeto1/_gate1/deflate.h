@@ -0,0 +1,27 @@
+/// deflate - A small, dependency-free zlib (RFC 1950) compressor,
+///           using the DEFLATE format (RFC 1951) with fixed Huffman codes
+///           and an LZ77 matcher based on hash chains
+///
+/// This module is part of a programming project
+/// for the course AED, DETI / UA.PT
+///
+/// You may freely use and modify this code, at your own risk,
+/// as long as you give proper credit to the original and subsequent authors.
+///
+/// The AED Team <jmadeira@ua.pt, jmr@ua.pt, ...>
+/// 2025
+
+#ifndef _DEFLATE_H_
+#define _DEFLATE_H_
+
+#include <inttypes.h>
+#include <stddef.h>
+
+/// Compress size bytes of data into a zlib stream.
+/// The length of the stream is stored in (*out_size).
+///
+/// On success, a new array with the stream is returned.
+/// (The caller is responsible for freeing the returned array!)
+uint8_t* ZlibCompress(const uint8_t* data, size_t size, size_t* out_size);
+
+#endif  // _DEFLATE_H_
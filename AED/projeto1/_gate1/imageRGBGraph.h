@@ -0,0 +1,29 @@
+/// imageRGBGraph - Building graphs from segmented imageRGB images,
+///                 using the Graph module of the second project
+///
+/// This module is part of a programming project
+/// for the course AED, DETI / UA.PT
+///
+/// You may freely use and modify this code, at your own risk,
+/// as long as you give proper credit to the original and subsequent authors.
+///
+/// The AED Team <jmadeira@ua.pt, jmr@ua.pt, ...>
+/// 2025
+
+#ifndef IMAGERGBGRAPH_H
+#define IMAGERGBGRAPH_H
+
+#include "Graph.h"
+#include "imageRGB.h"
+
+/// Build the region adjacency graph of a segmented image.
+/// The graph is undirected and unweighted, with one vertex per region
+/// label (the vertex index is the label) and an edge between every
+/// two regions that touch, directly or across a BLACK contour pixel.
+/// BLACK is not a region: it is never a vertex.
+///
+/// On success, a new graph is returned.
+/// (The caller is responsible for destroying the returned graph!)
+Graph* ImageBuildRegionAdjacencyGraph(const Image img);
+
+#endif
@@ -0,0 +1,252 @@
+// imageRGBTest - A program that performs some operations on RGB images.
+//
+// This program is an example use of the imageRGB module,
+// a programming project for the course AED, DETI / UA.PT
+//
+// You may freely use and modify this code, NO WARRANTY, blah blah,
+// as long as you give proper credit to the original and subsequent authors.
+//
+// The AED Team <jmadeira@ua.pt, jmr@ua.pt, ...>
+// 2025
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "error.h"
+#include "imageRGB.h"
+#include "instrumentation.h"
+
+int main(int argc, char* argv[]) {
+  program_name = argv[0];
+  if (argc != 1) {
+    error(1, 0, "Usage: imageRGBTest");
+  }
+
+  ImageInit();
+
+  // Creating and displaying some images
+
+  printf("1) ImageCreate\n");
+  Image white_image = ImageCreate(100, 100);
+  // ImageRAWPrint(white_image);
+
+  printf("2) ImageCreateChess(black)+ ImageSavePBM\n");
+  Image image_chess_1 = ImageCreateChess(150, 120, 30, 0x000000);  // black
+  // ImageRAWPrint(image_chess_1);
+  ImageSavePBM(image_chess_1, "chess_image_1.pbm");
+
+  printf("3) ImageCreateChess(red) + ImageSavePPM\n");
+  Image image_chess_2 = ImageCreateChess(20, 20, 8, 0xff0000);  // red
+  ImageRAWPrint(image_chess_2);
+  ImageSavePPM(image_chess_2, "chess_image_2.ppm");
+
+  printf("4) ImageCreateChess(all black)\n");
+  Image black_image = ImageCreateChess(100, 100, 100, 0x000000);  // all black
+  // ImageRAWPrint(black_image);
+  ImageSavePBM(black_image, "black_image.pbm");
+
+  printf("5) ImageCopy\n");
+  Image copy_image = ImageCopy(image_chess_1);
+  // ImageRAWPrint(copy_image);
+  if (copy_image != NULL) {
+    ImageSavePBM(copy_image, "copy_image.pbm");
+  }
+
+  printf("6) ImageLoadPBM\n");
+  Image image_1 = ImageLoadPBM("img/feep.pbm");
+  ImageRAWPrint(image_1);
+
+  printf("7) ImageLoadPPM\n");
+  Image image_2 = ImageLoadPPM("img/feep.ppm");
+  ImageRAWPrint(image_2);
+
+  printf("8) ImageCreatePalete\n");
+  Image image_3 = ImageCreatePalete(4 * 32, 4 * 32, 4);
+  ImageSavePPM(image_3, "palete.ppm");
+
+  printf("9) ImageDistanceTransform\n");
+  double* dist = ImageDistanceTransform(image_1);
+  double max_dist = 0.0;
+  for (uint32 i = 0; i < ImageWidth(image_1) * ImageHeight(image_1); i++) {
+    if (dist[i] > max_dist) max_dist = dist[i];
+  }
+  printf("Max distance to a contour pixel = %.3f\n", max_dist);
+  free(dist);
+
+  printf("10) ImageTraceRegionBoundary\n");
+  PixelCoords* outline = NULL;
+  double perimeter;
+  int n = ImageTraceRegionBoundary(image_chess_1, 0, 0, &outline, &perimeter);
+  printf("Outline of region at (0,0): %d pixels, perimeter = %.3f\n", n,
+         perimeter);
+  free(outline);
+
+  printf("11) ImageView + ImageMaterialize\n");
+  Image view = ImageView(image_chess_1, 30, 30, 60, 60);
+  // The region starts at a square corner: the same pattern, smaller
+  Image expected = ImageCreateChess(60, 60, 30, 0x000000);
+  printf("View is equal to the expected region? %d\n",
+         ImageIsEqual(view, expected));
+  assert(ImageIsEqual(view, expected));
+  Image rotated = ImageRotate180CW(view);
+  Image rotated_back = ImageRotate180CW(rotated);
+  printf("View is equal to its rotated back copy? %d\n",
+         ImageIsEqual(view, rotated_back));
+  assert(ImageIsEqual(view, rotated_back));
+  Image chess_before = ImageCopy(image_chess_1);
+  ImageMaterialize(view);
+  ImageRegionFillingWithQUEUE(view, 0, 0, WHITE);
+  printf("Materialized view changed? %d Parent unchanged? %d\n",
+         !ImageIsEqual(view, expected),
+         ImageIsEqual(image_chess_1, chess_before));
+  assert(!ImageIsEqual(view, expected));
+  assert(ImageIsEqual(image_chess_1, chess_before));
+  ImageDestroy(&view);
+  ImageDestroy(&expected);
+  ImageDestroy(&rotated);
+  ImageDestroy(&rotated_back);
+  ImageDestroy(&chess_before);
+
+  printf("12) ImageBuildPyramid\n");
+  Image* pyramid = ImageBuildPyramid(image_chess_1, 3);
+  for (int k = 0; k < 3; k++) {
+    printf("Level %d: %u x %u\n", k + 1, ImageWidth(pyramid[k]),
+           ImageHeight(pyramid[k]));
+    ImageDestroy(&pyramid[k]);
+  }
+  free(pyramid);
+
+  printf("13) ImageSavePNG\n");
+  ImageSavePNG(image_chess_1, "chess_image_1.png");
+  ImageSavePNG(image_3, "palete.png");
+
+  printf("14) ImageSaveLUT + ImageLoadLUT\n");
+  ImageSaveLUT(image_3, "palete.lut", 0);
+  ImageSaveLUT(image_chess_1, "chess_image_1.lut", 1);
+  Image loaded_3 = ImageLoadLUT("palete.lut");
+  Image loaded_chess = ImageLoadLUT("chess_image_1.lut");
+  printf("Loaded images are equal? %d %d\n", ImageIsEqual(loaded_3, image_3),
+         ImageIsEqual(loaded_chess, image_chess_1));
+  ImageDestroy(&loaded_3);
+  ImageDestroy(&loaded_chess);
+
+  printf("15) ImageRotate90CW + ImageRegionFillingWithQUEUE\n");
+  // Wide enough for each row-major write to miss the cache
+  Image big = ImageCreatePalete(6000, 4000, 7);
+  printf("Rotation by blocks (6000 x 4000)\n");
+  InstrReset();
+  Image big_rotated = ImageRotate90CW(big);
+  InstrPrint();
+  printf("Rotation row by row (6000 x 4000)\n");
+  InstrReset();
+  Image big_rotated_rows = ImageRotate90CWRowMajor(big);
+  InstrPrint();
+  printf("Rotations are equal? %d\n",
+         ImageIsEqual(big_rotated, big_rotated_rows));
+  assert(ImageIsEqual(big_rotated, big_rotated_rows));
+  ImageDestroy(&big);
+  ImageDestroy(&big_rotated);
+  ImageDestroy(&big_rotated_rows);
+  big = ImageCreate(2000, 1500);
+  printf("Filling (2000 x 1500)\n");
+  InstrReset();
+  int filled = ImageRegionFillingWithQUEUE(big, 1000, 750, BLACK);
+  InstrPrint();
+  printf("Filled %d pixels\n", filled);
+  ImageDestroy(&big);
+
+  printf("16) ImageHistogram + ImageCompactLUT\n");
+  Image segmented = ImageCopy(image_chess_1);
+  ImageSegmentation(segmented, ImageRegionFillingWithQUEUE);
+  ImageRegionFillingWithQUEUE(segmented, 30, 0, BLACK);
+  uint32 counts[FIXED_LUT_SIZE];
+  ImageHistogram(segmented, counts);
+  printf("Colors = %u, used = %u, BLACK pixels = %u\n",
+         ImageColors(segmented), ImageCountUsedColors(segmented),
+         counts[BLACK]);
+  ImageCompactLUT(segmented);
+  printf("After compacting: colors = %u, used = %u\n", ImageColors(segmented),
+         ImageCountUsedColors(segmented));
+  ImageDestroy(&segmented);
+
+  printf("17) ImagePaste\n");
+  Image canvas = ImageCreate(200, 150);
+  // The same labels as the canvas: the rows are copied as they are
+  ImagePaste(canvas, image_chess_2, 0, 0);
+  ImagePaste(canvas, image_chess_1, 20, 10);
+  // A tile of the palete, clipped at the bottom-right corner: its labels
+  // are remapped, and only its colors are added to the canvas LUT
+  Image tile = ImageView(image_3, 40, 40, 40, 40);
+  ImagePaste(canvas, tile, 170, 130);
+  Image pasted_chess = ImageView(canvas, 20, 10, 150, 120);
+  Image pasted_tile = ImageView(canvas, 170, 130, 30, 20);
+  Image clipped_tile = ImageView(tile, 0, 0, 30, 20);
+  Image kept = ImageView(canvas, 0, 0, 20, 10);
+  Image expected_kept = ImageView(image_chess_2, 0, 0, 20, 10);
+  printf("Pasted images are equal? %d %d %d\n",
+         ImageIsEqual(pasted_chess, image_chess_1),
+         ImageIsEqual(pasted_tile, clipped_tile),
+         ImageIsEqual(kept, expected_kept));
+  assert(ImageIsEqual(pasted_chess, image_chess_1));
+  assert(ImageIsEqual(pasted_tile, clipped_tile));
+  assert(ImageIsEqual(kept, expected_kept));
+  printf("Canvas colors = %u, used = %u\n", ImageColors(canvas),
+         ImageCountUsedColors(canvas));
+  ImageDestroy(&pasted_chess);
+  ImageDestroy(&pasted_tile);
+  ImageDestroy(&clipped_tile);
+  ImageDestroy(&kept);
+  ImageDestroy(&expected_kept);
+  ImageDestroy(&tile);
+  ImageDestroy(&canvas);
+
+  printf("18) ImageToRGB24 + ImageFromRGB24 + ImageToRGBA32\n");
+  uint32 npixels = ImageWidth(image_2) * ImageHeight(image_2);
+  uint8* rgb = malloc(3 * npixels);
+  uint8* rgba = malloc(4 * npixels);
+  assert(rgb != NULL && rgba != NULL);
+  ImageToRGB24(image_2, rgb);
+  Image from_rgb =
+      ImageFromRGB24(rgb, ImageWidth(image_2), ImageHeight(image_2));
+  ImageToRGBA32(image_2, rgba);
+  int same_colors = 1;
+  int opaque = 1;
+  for (uint32 i = 0; i < npixels; i++) {
+    same_colors = same_colors && memcmp(rgb + 3 * i, rgba + 4 * i, 3) == 0;
+    opaque = opaque && rgba[4 * i + 3] == 0xff;
+  }
+  printf("Round trip is equal? %d RGBA colors equal? %d Opaque? %d\n",
+         ImageIsEqual(from_rgb, image_2), same_colors, opaque);
+  assert(ImageIsEqual(from_rgb, image_2));
+  assert(same_colors && opaque);
+  ImageDestroy(&from_rgb);
+  free(rgb);
+  free(rgba);
+
+  printf("19) ImageBuildPyramidRGB24\n");
+  uint8** levels = ImageBuildPyramidRGB24(image_chess_1, 2);
+  // A 2x2 block inside a chess square keeps its color
+  printf("Level 1, pixel (0,0) = %02x%02x%02x\n", levels[0][0], levels[0][1],
+         levels[0][2]);
+  assert(levels[0][0] == 0x00 && levels[0][1] == 0x00 && levels[0][2] == 0x00);
+  for (int k = 0; k < 2; k++) {
+    free(levels[k]);
+  }
+  free(levels);
+
+  ImageDestroy(&white_image);
+  ImageDestroy(&black_image);
+  if (copy_image != NULL) {
+    ImageDestroy(&copy_image);
+  }
+  ImageDestroy(&image_chess_1);
+  ImageDestroy(&image_chess_2);
+  ImageDestroy(&image_1);
+  ImageDestroy(&image_2);
+  ImageDestroy(&image_3);
+
+  return 0;
+}
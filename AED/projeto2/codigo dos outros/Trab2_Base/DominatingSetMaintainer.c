@@ -0,0 +1,249 @@
+//
+// Algoritmos e Estruturas de Dados --- 2025/2026
+//
+// DominatingSetMaintainer - A dominating set of a changing UNDIRECTED graph
+//
+
+#include "DominatingSetMaintainer.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "DominationChecker.h"
+#include "Graph.h"
+#include "IndicesSet.h"
+
+struct _DominatingSetMaintainer {
+  Graph* g;
+  unsigned int range;    // Vertex indices in { 0, ..., (range - 1) }
+  DominationChecker* d;  // The current dominating set, and its counts
+};
+
+// The graph changes all the time: the checker, and the adjacents below,
+// are taken from the edges lists, and not from a frozen snapshot
+
+static unsigned int _Count(const DominatingSetMaintainer* m, unsigned int v) {
+  return DominationCheckerGetCount(m->d, v);
+}
+
+static int _InSet(const DominatingSetMaintainer* m, unsigned int v) {
+  return IndicesSetContains(DominationCheckerGetSet(m->d), v);
+}
+
+// Number of undominated vertices in N[v]
+static unsigned int _Gain(const DominatingSetMaintainer* m, unsigned int v) {
+  unsigned int gain = (_Count(m, v) == 0);
+  GraphAdjacentsIter it;
+  for (int w = GraphAdjacentsIterFirst(&it, m->g, v); w != -1;
+       w = GraphAdjacentsIterNext(&it)) {
+    gain += (_Count(m, (unsigned int)w) == 0);
+  }
+  return gain;
+}
+
+// Remove v from the set, if all the vertices it dominates are also
+// dominated by another vertex of the set
+static void _TryDrop(DominatingSetMaintainer* m, unsigned int v) {
+  if (_InSet(m, v) == 0 || _Count(m, v) < 2) return;
+
+  GraphAdjacentsIter it;
+  for (int w = GraphAdjacentsIterFirst(&it, m->g, v); w != -1;
+       w = GraphAdjacentsIterNext(&it)) {
+    if (_Count(m, (unsigned int)w) < 2) return;
+  }
+
+  DominationCheckerRemove(m->d, v);
+}
+
+// Try to drop the vertices of the set in N[v], except v itself
+static void _DropAround(DominatingSetMaintainer* m, unsigned int v) {
+  GraphAdjacentsIter it;
+  for (int w = GraphAdjacentsIterFirst(&it, m->g, v); w != -1;
+       w = GraphAdjacentsIterNext(&it)) {
+    _TryDrop(m, (unsigned int)w);
+  }
+}
+
+// If v is undominated, add the vertex of N[v] that dominates more
+// undominated vertices; the counts increase only in its closed
+// neighbourhood, so only the vertices of the set at distance up to 2 of it
+// may no longer be needed
+static void _Repair(DominatingSetMaintainer* m, unsigned int v) {
+  if (_Count(m, v) > 0) return;
+
+  unsigned int best = v;
+  unsigned int bestGain = _Gain(m, v);
+  GraphAdjacentsIter it;
+  for (int w = GraphAdjacentsIterFirst(&it, m->g, v); w != -1;
+       w = GraphAdjacentsIterNext(&it)) {
+    unsigned int gain = _Gain(m, (unsigned int)w);
+    if (gain > bestGain) {
+      best = (unsigned int)w;
+      bestGain = gain;
+    }
+  }
+
+  DominationCheckerAdd(m->d, best);
+  _DropAround(m, best);
+  for (int w = GraphAdjacentsIterFirst(&it, m->g, best); w != -1;
+       w = GraphAdjacentsIterNext(&it)) {
+    _DropAround(m, (unsigned int)w);
+  }
+}
+
+DominatingSetMaintainer* DominatingSetMaintainerCreate(Graph* g,
+                                                       const IndicesSet* set) {
+  assert(g != NULL);
+  assert(GraphIsDigraph(g) == 0);
+
+  DominatingSetMaintainer* m = malloc(sizeof(struct _DominatingSetMaintainer));
+  if (m == NULL) abort();
+
+  m->g = g;
+  m->range = GraphGetVertexRange(g);
+  m->d = DominationCheckerCreateForChanges(g);
+
+  IndicesSet* vertices = GraphGetSetVertices(g);
+  IndicesSetIter it;
+  if (set != NULL) {
+    assert(IndicesSetIsSubset(set, vertices));
+    for (int v = IndicesSetIterFirst(&it, set); v != -1;
+         v = IndicesSetIterNext(&it)) {
+      DominationCheckerAdd(m->d, (unsigned int)v);
+    }
+  }
+  for (int v = IndicesSetIterFirst(&it, vertices); v != -1;
+       v = IndicesSetIterNext(&it)) {
+    _Repair(m, (unsigned int)v);
+  }
+  IndicesSetDestroy(&vertices);
+
+  return m;
+}
+
+void DominatingSetMaintainerDestroy(DominatingSetMaintainer** p) {
+  assert(*p != NULL);
+  DominatingSetMaintainer* m = *p;
+
+  DominationCheckerDestroy(&(m->d));
+  free(m);
+
+  *p = NULL;
+}
+
+int DominatingSetMaintainerAddVertex(DominatingSetMaintainer* m,
+                                     unsigned int v) {
+  if (GraphAddVertex(m->g, v) == 0) {
+    return 0;
+  }
+
+  // Isolated: only itself can dominate it
+  DominationCheckerVertexAdded(m->d, v);
+  _Repair(m, v);
+  return 1;
+}
+
+int DominatingSetMaintainerRemoveVertex(DominatingSetMaintainer* m,
+                                        unsigned int v) {
+  assert(v < m->range);
+
+  if (GraphContainsVertex(m->g, v) == 0) {
+    return 0;
+  }
+
+  int wasInSet = _InSet(m, v);
+  if (wasInSet) DominationCheckerRemove(m->d, v);
+
+  // Its adjacents, kept before removing its edges
+  unsigned int degree = GraphGetVertexDegree(m->g, v);
+  unsigned int* adjacents = malloc((degree + 1) * sizeof(unsigned int));
+  if (adjacents == NULL) abort();
+  unsigned int k = 0;
+  GraphAdjacentsIter it;
+  for (int w = GraphAdjacentsIterFirst(&it, m->g, v); w != -1;
+       w = GraphAdjacentsIterNext(&it)) {
+    adjacents[k++] = (unsigned int)w;
+  }
+  GraphRemoveVertex(m->g, v);
+  DominationCheckerVertexRemoved(m->d, v);
+
+  // Its adjacents may be left undominated, if v was in the set;
+  // and those in the set now dominate fewer vertices
+  for (k = 0; k < degree; k++) {
+    if (wasInSet) _Repair(m, adjacents[k]);
+    _TryDrop(m, adjacents[k]);
+  }
+  free(adjacents);
+  return 1;
+}
+
+// Update the counts for the new edge (v,w): the vertices of the set in
+// N[v] or N[w] may no longer be needed
+static void _EdgeAdded(DominatingSetMaintainer* m, unsigned int v,
+                       unsigned int w) {
+  DominationCheckerEdgeAdded(m->d, v, w);
+
+  _TryDrop(m, v);
+  _DropAround(m, v);
+  _TryDrop(m, w);
+  _DropAround(m, w);
+}
+
+int DominatingSetMaintainerAddEdge(DominatingSetMaintainer* m, unsigned int v,
+                                   unsigned int w) {
+  if (GraphAddEdge(m->g, v, w) == 0) {
+    return 0;
+  }
+  _EdgeAdded(m, v, w);
+  return 1;
+}
+
+int DominatingSetMaintainerAddWeightedEdge(DominatingSetMaintainer* m,
+                                           unsigned int v, unsigned int w,
+                                           double weight) {
+  if (GraphAddWeightedEdge(m->g, v, w, weight) == 0) {
+    return 0;
+  }
+  _EdgeAdded(m, v, w);
+  return 1;
+}
+
+int DominatingSetMaintainerRemoveEdge(DominatingSetMaintainer* m,
+                                      unsigned int v, unsigned int w) {
+  if (GraphRemoveEdge(m->g, v, w) == 0) {
+    return 0;
+  }
+
+  // v and w may be left undominated; if not, and in the set, they now
+  // dominate fewer vertices
+  DominationCheckerEdgeRemoved(m->d, v, w);
+  _Repair(m, v);
+  _Repair(m, w);
+  _TryDrop(m, v);
+  _TryDrop(m, w);
+  return 1;
+}
+
+void DominatingSetMaintainerRecompute(DominatingSetMaintainer* m,
+                                      IndicesSet* (*solve)(const Graph* g)) {
+  IndicesSet* set = solve(m->g);
+
+  DominationCheckerClear(m->d);
+  IndicesSetIter it;
+  for (int v = IndicesSetIterFirst(&it, set); v != -1;
+       v = IndicesSetIterNext(&it)) {
+    DominationCheckerAdd(m->d, (unsigned int)v);
+  }
+  IndicesSetDestroy(&set);
+}
+
+const IndicesSet* DominatingSetMaintainerGetSet(
+    const DominatingSetMaintainer* m) {
+  return DominationCheckerGetSet(m->d);
+}
+
+unsigned int DominatingSetMaintainerGetCount(const DominatingSetMaintainer* m,
+                                             unsigned int v) {
+  assert(v < m->range);
+  return _Count(m, v);
+}
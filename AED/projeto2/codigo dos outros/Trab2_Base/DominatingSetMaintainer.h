@@ -0,0 +1,66 @@
+//
+// Algoritmos e Estruturas de Dados --- 2025/2026
+//
+// DominatingSetMaintainer - A dominating set of a changing UNDIRECTED graph
+//
+// Keeps a dominating set S of the graph and, for each vertex v, the number
+// of vertices of S in its closed neighbourhood N[v], in a DominationChecker
+// that follows the changes of the graph. The graph is changed through the
+// maintainer, which repairs S locally after each change:
+//  - a vertex left undominated is dominated again by the vertex of its
+//    closed neighbourhood that dominates more undominated vertices;
+//  - the vertices of S near the change that are no longer needed (all the
+//    vertices they dominate are also dominated by another one) are removed.
+// S is then a dominating set, but not necessarily a minimum one: it is
+// computed from scratch only on request.
+//
+// The graph must NOT be modified directly while the maintainer is in use.
+//
+
+#ifndef _DOMINATING_SET_MAINTAINER_
+#define _DOMINATING_SET_MAINTAINER_
+
+#include "Graph.h"
+#include "IndicesSet.h"
+
+typedef struct _DominatingSetMaintainer DominatingSetMaintainer;
+
+// Create a maintainer for the graph, starting with the given set
+// (or the empty set, if NULL), repaired to be a dominating set
+DominatingSetMaintainer* DominatingSetMaintainerCreate(Graph* g,
+                                                       const IndicesSet* set);
+
+void DominatingSetMaintainerDestroy(DominatingSetMaintainer** p);
+
+// Change the graph, and repair the set
+// Return as the corresponding Graph functions
+int DominatingSetMaintainerAddVertex(DominatingSetMaintainer* m,
+                                     unsigned int v);
+
+int DominatingSetMaintainerRemoveVertex(DominatingSetMaintainer* m,
+                                        unsigned int v);
+
+int DominatingSetMaintainerAddEdge(DominatingSetMaintainer* m, unsigned int v,
+                                   unsigned int w);
+
+int DominatingSetMaintainerAddWeightedEdge(DominatingSetMaintainer* m,
+                                           unsigned int v, unsigned int w,
+                                           double weight);
+
+int DominatingSetMaintainerRemoveEdge(DominatingSetMaintainer* m,
+                                      unsigned int v, unsigned int w);
+
+// Replace the set by the one computed from scratch by solve
+// (e.g., GraphComputeMinDominatingSetBnB)
+void DominatingSetMaintainerRecompute(DominatingSetMaintainer* m,
+                                      IndicesSet* (*solve)(const Graph* g));
+
+// The current dominating set (do NOT modify or destroy it)
+const IndicesSet* DominatingSetMaintainerGetSet(
+    const DominatingSetMaintainer* m);
+
+// Number of vertices of the set in N[v]
+unsigned int DominatingSetMaintainerGetCount(const DominatingSetMaintainer* m,
+                                             unsigned int v);
+
+#endif  // _DOMINATING_SET_MAINTAINER_
@@ -0,0 +1,174 @@
+//
+// Algoritmos e Estruturas de Dados --- 2025/2026
+//
+// DominationChecker - Incremental domination tests for UNDIRECTED graphs
+//
+
+#include "DominationChecker.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Graph.h"
+#include "IndicesSet.h"
+
+struct _DominationChecker {
+  const Graph* g;
+  const GraphCSR* csr;    // The frozen graph, or NULL if following changes
+  unsigned int range;     // Vertex indices in { 0, ..., (range - 1) }
+  IndicesSet* set;        // The current set
+  unsigned int* count;    // For each vertex v, |set intersected with N[v]|
+  unsigned int numUndominated;  // Number of vertices with count 0
+};
+
+static DominationChecker* _Create(const Graph* g, const GraphCSR* csr) {
+  assert(g != NULL);
+  assert(GraphIsDigraph(g) == 0);
+
+  DominationChecker* d = malloc(sizeof(struct _DominationChecker));
+  if (d == NULL) abort();
+
+  d->g = g;
+  d->csr = csr;
+  d->range = GraphGetVertexRange(g);
+  d->set = IndicesSetCreateEmpty(d->range);
+  d->count = calloc(d->range, sizeof(unsigned int));
+  if (d->count == NULL) abort();
+  d->numUndominated = GraphGetNumVertices(g);
+
+  return d;
+}
+
+DominationChecker* DominationCheckerCreate(const Graph* g) {
+  return _Create(g, GraphFreeze(g));
+}
+
+DominationChecker* DominationCheckerCreateForChanges(const Graph* g) {
+  return _Create(g, NULL);
+}
+
+void DominationCheckerDestroy(DominationChecker** p) {
+  assert(*p != NULL);
+  DominationChecker* d = *p;
+
+  free(d->count);
+  IndicesSetDestroy(&(d->set));
+  free(d);
+
+  *p = NULL;
+}
+
+void DominationCheckerClear(DominationChecker* d) {
+  IndicesSetDestroy(&(d->set));
+  d->set = IndicesSetCreateEmpty(d->range);
+  memset(d->count, 0, d->range * sizeof(unsigned int));
+  d->numUndominated = GraphGetNumVertices(d->g);
+}
+
+static void _Increment(DominationChecker* d, unsigned int v) {
+  if (d->count[v]++ == 0) d->numUndominated--;
+}
+
+static void _Decrement(DominationChecker* d, unsigned int v) {
+  if (--d->count[v] == 0) d->numUndominated++;
+}
+
+int DominationCheckerAdd(DominationChecker* d, unsigned int v) {
+  assert(GraphContainsVertex(d->g, v));
+
+  if (IndicesSetAdd(d->set, v) == 0) {
+    return 0;
+  }
+
+  // N[v] = {v} + the adjacents of v
+  _Increment(d, v);
+  if (d->csr != NULL) {
+    unsigned int degree = GraphCSRGetDegree(d->csr, v);
+    const uint32_t* adjacents = GraphCSRGetAdjacents(d->csr, v);
+    for (unsigned int k = 0; k < degree; k++) {
+      _Increment(d, adjacents[k]);
+    }
+  } else {
+    GraphAdjacentsIter it;
+    for (int w = GraphAdjacentsIterFirst(&it, d->g, v); w != -1;
+         w = GraphAdjacentsIterNext(&it)) {
+      _Increment(d, (unsigned int)w);
+    }
+  }
+
+  return 1;
+}
+
+int DominationCheckerRemove(DominationChecker* d, unsigned int v) {
+  assert(GraphContainsVertex(d->g, v));
+
+  if (IndicesSetRemove(d->set, v) == 0) {
+    return 0;
+  }
+
+  _Decrement(d, v);
+  if (d->csr != NULL) {
+    unsigned int degree = GraphCSRGetDegree(d->csr, v);
+    const uint32_t* adjacents = GraphCSRGetAdjacents(d->csr, v);
+    for (unsigned int k = 0; k < degree; k++) {
+      _Decrement(d, adjacents[k]);
+    }
+  } else {
+    GraphAdjacentsIter it;
+    for (int w = GraphAdjacentsIterFirst(&it, d->g, v); w != -1;
+         w = GraphAdjacentsIterNext(&it)) {
+      _Decrement(d, (unsigned int)w);
+    }
+  }
+
+  return 1;
+}
+
+const IndicesSet* DominationCheckerGetSet(const DominationChecker* d) {
+  return d->set;
+}
+
+unsigned int DominationCheckerGetCount(const DominationChecker* d,
+                                       unsigned int v) {
+  assert(v < d->range);
+  return d->count[v];
+}
+
+unsigned int DominationCheckerGetNumUndominated(const DominationChecker* d) {
+  return d->numUndominated;
+}
+
+int DominationCheckerIsDominating(const DominationChecker* d) {
+  return d->numUndominated == 0;
+}
+
+// A new vertex is isolated: only itself could dominate it
+void DominationCheckerVertexAdded(DominationChecker* d, unsigned int v) {
+  assert(d->csr == NULL);
+  assert(GraphContainsVertex(d->g, v));
+  d->count[v] = 0;
+  d->numUndominated++;
+}
+
+// Not in the set: its removal changes no other count
+void DominationCheckerVertexRemoved(DominationChecker* d, unsigned int v) {
+  assert(d->csr == NULL);
+  assert(v < d->range && IndicesSetContains(d->set, v) == 0);
+  if (d->count[v] == 0) d->numUndominated--;
+  d->count[v] = 0;
+}
+
+void DominationCheckerEdgeAdded(DominationChecker* d, unsigned int v,
+                                unsigned int w) {
+  assert(d->csr == NULL);
+  if (IndicesSetContains(d->set, v)) _Increment(d, w);
+  if (IndicesSetContains(d->set, w)) _Increment(d, v);
+}
+
+void DominationCheckerEdgeRemoved(DominationChecker* d, unsigned int v,
+                                  unsigned int w) {
+  assert(d->csr == NULL);
+  if (IndicesSetContains(d->set, v)) _Decrement(d, w);
+  if (IndicesSetContains(d->set, w)) _Decrement(d, v);
+}
@@ -0,0 +1,68 @@
+//
+// Algoritmos e Estruturas de Dados --- 2025/2026
+//
+// DominationChecker - Incremental domination tests for UNDIRECTED graphs
+//
+// Keeps a set S of graph vertices and, for each vertex v, the number of
+// vertices of S in its closed neighbourhood N[v] = {v} + adjacents of v.
+// Adding or removing a vertex costs O(degree), and checking if S is a
+// dominating set costs O(1): it is when no vertex has count 0.
+//
+// The checker uses the frozen (CSR) snapshot of the graph:
+// the graph must NOT be modified while the checker is in use.
+// A checker created to follow the changes of the graph reads its edges
+// lists instead, and must be told of each change.
+//
+
+#ifndef _DOMINATION_CHECKER_
+#define _DOMINATION_CHECKER_
+
+#include "Graph.h"
+#include "IndicesSet.h"
+
+typedef struct _DominationChecker DominationChecker;
+
+// Create a checker for the graph, with the empty set
+DominationChecker* DominationCheckerCreate(const Graph* g);
+
+// Create a checker that follows the changes of the graph, with the empty set
+DominationChecker* DominationCheckerCreateForChanges(const Graph* g);
+
+void DominationCheckerDestroy(DominationChecker** p);
+
+// Back to the empty set
+void DominationCheckerClear(DominationChecker* d);
+
+// Add / remove vertex v to / from the set
+// Return 1 on success, 0 if already in / not in the set
+int DominationCheckerAdd(DominationChecker* d, unsigned int v);
+
+int DominationCheckerRemove(DominationChecker* d, unsigned int v);
+
+// The current set (do NOT modify or destroy it)
+const IndicesSet* DominationCheckerGetSet(const DominationChecker* d);
+
+// Number of vertices of the set in N[v]
+unsigned int DominationCheckerGetCount(const DominationChecker* d,
+                                       unsigned int v);
+
+// Number of vertices not dominated by the set
+unsigned int DominationCheckerGetNumUndominated(const DominationChecker* d);
+
+// Is the set a dominating set of the graph?
+int DominationCheckerIsDominating(const DominationChecker* d);
+
+// For a checker that follows the changes of the graph: update the counts
+// after each change made to the graph
+// A vertex must be removed from the set before being removed from the graph
+void DominationCheckerVertexAdded(DominationChecker* d, unsigned int v);
+
+void DominationCheckerVertexRemoved(DominationChecker* d, unsigned int v);
+
+void DominationCheckerEdgeAdded(DominationChecker* d, unsigned int v,
+                                unsigned int w);
+
+void DominationCheckerEdgeRemoved(DominationChecker* d, unsigned int v,
+                                  unsigned int w);
+
+#endif  // _DOMINATION_CHECKER_
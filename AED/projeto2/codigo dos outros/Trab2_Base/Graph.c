@@ -30,6 +30,7 @@ struct _Vertex {
   unsigned int inDegree;
   unsigned int outDegree;
   List* edgesList;
+  ListNode* node;  // Its node in the vertices list
 };
 
 struct _Edge {
@@ -46,6 +47,17 @@ struct _GraphHeader {
   unsigned int numEdges;
   IndicesSet* verticesSet;  // To store the vertex indices
   List* verticesList;
+  struct _Vertex** vertexIndex;  // The vertex data of each index, or NULL
+  GraphCSR* frozen;  // Cached CSR snapshot, or NULL if not built / outdated
+};
+
+struct _GraphCSR {
+  unsigned int indicesRange;
+  unsigned int numVertices;
+  uint32_t* vertices;   // numVertices vertex indices, in increasing order
+  uint32_t* offsets;    // indicesRange + 1 positions in adjacents
+  uint32_t* adjacents;  // offsets[indicesRange] adjacent vertices
+  double* weights;      // The weights of those edges, or NULL
 };
 
 //
@@ -68,6 +80,15 @@ int graphEdgesComparator(const void* p1, const void* p2) {
   return (d > 0) - (d < 0);
 }
 
+//
+// The vertex data of vertex v, in O(1)
+//
+static struct _Vertex* _getVertex(const Graph* g, unsigned int v) {
+  assert(v < g->indicesRange);
+  assert(g->vertexIndex[v] != NULL);
+  return g->vertexIndex[v];
+}
+
 //
 // Create an empty graph: 0 vertices, 0 edges
 //
@@ -86,6 +107,10 @@ Graph* GraphCreateEmpty(unsigned int indicesRange, int isDigraph,
 
   g->verticesSet = IndicesSetCreateEmpty(indicesRange);
   g->verticesList = ListCreate(graphVerticesComparator);
+  g->vertexIndex =
+      (struct _Vertex**)calloc(indicesRange, sizeof(struct _Vertex*));
+  if (indicesRange > 0 && g->vertexIndex == NULL) abort();
+  g->frozen = NULL;
 
   assert((int)g->numVertices == (int)IndicesSetGetNumElems(g->verticesSet));
   assert((int)g->numVertices == ListGetSize(g->verticesList));
@@ -110,6 +135,10 @@ Graph* GraphCreate(unsigned int numVertices, int isDigraph, int isWeighted) {
 
   g->verticesSet = IndicesSetCreateFull(numVertices);
   g->verticesList = ListCreate(graphVerticesComparator);
+  g->vertexIndex =
+      (struct _Vertex**)calloc(numVertices, sizeof(struct _Vertex*));
+  if (numVertices > 0 && g->vertexIndex == NULL) abort();
+  g->frozen = NULL;
 
   for (unsigned int i = 0; i < numVertices; i++) {
     struct _Vertex* v = (struct _Vertex*)malloc(sizeof(struct _Vertex));
@@ -121,7 +150,8 @@ Graph* GraphCreate(unsigned int numVertices, int isDigraph, int isWeighted) {
 
     v->edgesList = ListCreate(graphEdgesComparator);
 
-    ListInsert(g->verticesList, v);
+    v->node = ListInsertGetNode(g->verticesList, v);
+    g->vertexIndex[i] = v;
   }
 
   assert((int)g->numVertices == (int)IndicesSetGetNumElems(g->verticesSet));
@@ -171,6 +201,22 @@ Graph* GraphCreateComplete(unsigned int numVertices, int isDigraph) {
   return g;
 }
 
+//
+// Discard the CSR snapshot, if any
+// To be called whenever the graph is modified
+//
+static void _GraphThaw(Graph* g) {
+  GraphCSR* c = g->frozen;
+  if (c == NULL) return;
+
+  free(c->vertices);
+  free(c->offsets);
+  free(c->adjacents);
+  free(c->weights);
+  free(c);
+  g->frozen = NULL;
+}
+
 void GraphDestroy(Graph** p) {
   assert(*p != NULL);
   Graph* g = *p;
@@ -196,6 +242,8 @@ void GraphDestroy(Graph** p) {
     }
   }
 
+  _GraphThaw(g);
+  free(g->vertexIndex);
   ListDestroy(&(g->verticesList));
   IndicesSetDestroy(&(g->verticesSet));
   free(g);
@@ -203,46 +251,170 @@ void GraphDestroy(Graph** p) {
   *p = NULL;
 }
 
+//
+// Helpers for GraphFromFile
+//
+
+// Read the rest of the file into a NUL-terminated buffer, in large blocks
+static char* _readAll(FILE* f) {
+  size_t capacity = 1 << 16;
+  size_t size = 0;
+  char* buffer = (char*)malloc(capacity);
+  if (buffer == NULL) abort();
+
+  size_t n;
+  while ((n = fread(buffer + size, 1, capacity - size - 1, f)) > 0) {
+    size += n;
+    if (capacity - size - 1 == 0) {
+      capacity *= 2;
+      buffer = (char*)realloc(buffer, capacity);
+      if (buffer == NULL) abort();
+    }
+  }
+  buffer[size] = '\0';
+
+  return buffer;
+}
+
+// Skip white space and read an unsigned integer, advancing *pp
+static unsigned int _scanUnsigned(char** pp) {
+  char* p = *pp;
+  while (*p == ' ' || *p == '\n' || *p == '\t' || *p == '\r') p++;
+
+  unsigned int value = 0;
+  while (*p >= '0' && *p <= '9') {
+    value = 10 * value + (unsigned int)(*p - '0');
+    p++;
+  }
+
+  *pp = p;
+  return value;
+}
+
+// Read a floating point number, advancing *pp
+static double _scanDouble(char** pp) {
+  char* end;
+  double value = strtod(*pp, &end);
+  *pp = end;
+  return value;
+}
+
+// Stable counting sort of the n positions in order[] by key[order[i]],
+// with keys in { 0, ..., range - 1 }; tmp is an auxiliary array of size n
+static void _countingSort(unsigned int n, const unsigned int* key,
+                          unsigned int range, unsigned int* order,
+                          unsigned int* tmp) {
+  unsigned int* count = (unsigned int*)calloc(range + 1, sizeof(unsigned int));
+  if (count == NULL) abort();
+
+  for (unsigned int i = 0; i < n; i++) {
+    count[key[order[i]] + 1]++;
+  }
+  for (unsigned int k = 0; k < range; k++) {
+    count[k + 1] += count[k];
+  }
+  for (unsigned int i = 0; i < n; i++) {
+    tmp[count[key[order[i]]]++] = order[i];
+  }
+  for (unsigned int i = 0; i < n; i++) {
+    order[i] = tmp[i];
+  }
+
+  free(count);
+}
+
 // Read a graph from file
 // Using the simple graph format of Sedgewick and Wayne
 // Input argument must be a valid FILE POINTER
 // File must be openend and closed by the caller
+//
+// The file is read at once, and the edges are sorted by (start, end)
+// vertex, with a two-pass radix sort: each edges list is then built in
+// increasing order, without searching.
+// As with GraphAddEdge, repeated edges are ignored (the first one is kept).
 Graph* GraphFromFile(FILE* f) {
   assert(f != NULL);
 
-  unsigned int isDigraph;
-  fscanf(f, "%u", &isDigraph);
-
-  unsigned int isWeighted;
-  fscanf(f, "%u", &isWeighted);
+  char* buffer = _readAll(f);
+  char* p = buffer;
 
-  unsigned int numVertices;
-  fscanf(f, "%u", &numVertices);
-
-  unsigned int numEdges;
-  fscanf(f, "%u", &numEdges);
+  unsigned int isDigraph = _scanUnsigned(&p);
+  unsigned int isWeighted = _scanUnsigned(&p);
+  unsigned int numVertices = _scanUnsigned(&p);
+  unsigned int numEdges = _scanUnsigned(&p);
 
   Graph* g = GraphCreate(numVertices, isDigraph, isWeighted);
 
-  // Read the edges and add them to the graph
-  unsigned int start_vertex;
-  unsigned int end_vertex;
-  double weight;
+  // Read the edges: for a graph, each edge is stored in both directions
+  unsigned int n = (isDigraph ? 1 : 2) * numEdges;
+  unsigned int* start = (unsigned int*)malloc(n * sizeof(unsigned int));
+  unsigned int* end = (unsigned int*)malloc(n * sizeof(unsigned int));
+  double* weight = (double*)malloc(n * sizeof(double));
+  unsigned int* order = (unsigned int*)malloc(n * sizeof(unsigned int));
+  unsigned int* tmp = (unsigned int*)malloc(n * sizeof(unsigned int));
+  if (n > 0 && (start == NULL || end == NULL || weight == NULL ||
+                order == NULL || tmp == NULL)) {
+    abort();
+  }
 
-  if (isWeighted == 0) {
-    for (unsigned int i = 0; i < numEdges; i++) {
-      fscanf(f, "%u", &start_vertex);
-      fscanf(f, "%u", &end_vertex);
-      GraphAddEdge(g, start_vertex, end_vertex);
+  unsigned int k = 0;
+  for (unsigned int i = 0; i < numEdges; i++) {
+    unsigned int v = _scanUnsigned(&p);
+    unsigned int w = _scanUnsigned(&p);
+    double wt = isWeighted ? _scanDouble(&p) : 1.0;
+    assert(v < numVertices && w < numVertices);
+    assert(v != w);
+
+    start[k] = v;
+    end[k] = w;
+    weight[k] = wt;
+    k++;
+    if (isDigraph == 0) {
+      start[k] = w;
+      end[k] = v;
+      weight[k] = wt;
+      k++;
     }
-  } else {
-    for (unsigned int i = 0; i < numEdges; i++) {
-      fscanf(f, "%u", &start_vertex);
-      fscanf(f, "%u", &end_vertex);
-      fscanf(f, "%lf", &weight);
-      GraphAddWeightedEdge(g, start_vertex, end_vertex, weight);
+  }
+  free(buffer);
+
+  // Sort by end vertex, then (stable) by start vertex
+  for (unsigned int i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  _countingSort(n, end, numVertices, order, tmp);
+  _countingSort(n, start, numVertices, order, tmp);
+
+  // Build the edges lists in one pass
+  // Repeated edges are consecutive: keep the first one read from the file
+  unsigned int stored = 0;
+  for (unsigned int i = 0; i < n; i++) {
+    unsigned int e = order[i];
+    if (i > 0 && start[e] == start[order[i - 1]] &&
+        end[e] == end[order[i - 1]]) {
+      continue;
+    }
+
+    struct _Edge* edge = (struct _Edge*)malloc(sizeof(struct _Edge));
+    if (edge == NULL) abort();
+    edge->adjVertex = end[e];
+    edge->weight = weight[e];
+
+    struct _Vertex* vertex = g->vertexIndex[start[e]];
+    ListInsert(vertex->edgesList, edge);  // appended at the tail
+    vertex->outDegree++;
+    if (isDigraph) {
+      g->vertexIndex[end[e]]->inDegree++;
     }
+    stored++;
   }
+  g->numEdges = isDigraph ? stored : stored / 2;
+
+  free(start);
+  free(end);
+  free(weight);
+  free(order);
+  free(tmp);
 
   assert(numEdges == g->numEdges);
 
@@ -263,44 +435,38 @@ Graph* GraphGetSubgraph(const Graph* g, IndicesSet* vertSet) {
   Graph* new = GraphCreateEmpty(g->indicesRange, g->isDigraph, g->isWeighted);
 
   // Add all vertices from the set to the new graph
-  int v = IndicesSetGetFirstElem(vertSet);
+  IndicesSetIter it;
+  int v = IndicesSetIterFirst(&it, vertSet);
   while (v != -1) {
     GraphAddVertex(new, (unsigned int)v);
-    v = IndicesSetGetNextElem(vertSet);
+    v = IndicesSetIterNext(&it);
   }
 
   // Add edges between vertices that are both in the set
-  v = IndicesSetGetFirstElem(vertSet);
+  const GraphCSR* c = GraphFreeze(g);
+  v = IndicesSetIterFirst(&it, vertSet);
   while (v != -1) {
-    // Find the vertex in the original graph
-    struct _Vertex search_dummy;
-    search_dummy.id = (unsigned int)v;
-    ListSearch(g->verticesList, (void*)(&search_dummy));
-    struct _Vertex* vertex = ListGetCurrentItem(g->verticesList);
-
-    // Check each edge from this vertex
-    List* edges = vertex->edgesList;
-    if (!ListIsEmpty(edges)) {
-      ListMoveToHead(edges);
-      for (int i = 0; i < ListGetSize(edges); i++, ListMoveToNext(edges)) {
-        struct _Edge* edge = ListGetCurrentItem(edges);
-        unsigned int w = edge->adjVertex;
-        
-        // Only add the edge if the target vertex is in the set
-        // For undirected graphs, only add if v <= w to avoid duplicates
-        if (IndicesSetContains(vertSet, (uint16_t)w)) {
-          if (g->isDigraph || (unsigned int)v <= w) {
-            if (g->isWeighted) {
-              GraphAddWeightedEdge(new, (unsigned int)v, w, edge->weight);
-            } else {
-              GraphAddEdge(new, (unsigned int)v, w);
-            }
+    unsigned int degree = GraphCSRGetDegree(c, (unsigned int)v);
+    const uint32_t* adjacents = GraphCSRGetAdjacents(c, (unsigned int)v);
+    const double* weights = GraphCSRGetWeights(c, (unsigned int)v);
+
+    for (unsigned int k = 0; k < degree; k++) {
+      unsigned int w = adjacents[k];
+
+      // Only add the edge if the target vertex is in the set
+      // For undirected graphs, only add if v <= w to avoid duplicates
+      if (IndicesSetContains(vertSet, w)) {
+        if (g->isDigraph || (unsigned int)v <= w) {
+          if (g->isWeighted) {
+            GraphAddWeightedEdge(new, (unsigned int)v, w, weights[k]);
+          } else {
+            GraphAddEdge(new, (unsigned int)v, w);
           }
         }
       }
     }
 
-    v = IndicesSetGetNextElem(vertSet);
+    v = IndicesSetIterNext(&it);
   }
 
   GraphCheckInvariants(new);
@@ -308,6 +474,56 @@ Graph* GraphGetSubgraph(const Graph* g, IndicesSet* vertSet) {
   return new;
 }
 
+//
+// For a graph
+//
+// Iterative depth-first search, on the CSR snapshot
+//
+IndicesSet** GraphGetConnectedComponents(const Graph* g,
+                                         unsigned int* numComponents) {
+  assert(g->isDigraph == 0);
+  assert(numComponents != NULL);
+
+  const GraphCSR* c = GraphFreeze(g);
+  const uint32_t* vertices = GraphCSRGetVertices(c);
+
+  // At most one component for each vertex
+  IndicesSet** components = malloc((g->numVertices + 1) * sizeof(IndicesSet*));
+  char* visited = calloc(g->indicesRange, sizeof(char));
+  uint32_t* stack = malloc((g->numVertices + 1) * sizeof(uint32_t));
+  if (components == NULL || visited == NULL || stack == NULL) abort();
+
+  unsigned int n = 0;
+  for (unsigned int i = 0; i < g->numVertices; i++) {
+    unsigned int root = vertices[i];
+    if (visited[root]) continue;
+
+    IndicesSet* component = IndicesSetCreateEmpty(g->indicesRange);
+    unsigned int top = 0;
+    stack[top++] = root;
+    visited[root] = 1;
+    while (top > 0) {
+      unsigned int v = stack[--top];
+      IndicesSetAdd(component, v);
+      unsigned int degree = GraphCSRGetDegree(c, v);
+      const uint32_t* adjacents = GraphCSRGetAdjacents(c, v);
+      for (unsigned int k = 0; k < degree; k++) {
+        // Each vertex is pushed only once
+        if (visited[adjacents[k]]) continue;
+        visited[adjacents[k]] = 1;
+        stack[top++] = adjacents[k];
+      }
+    }
+    components[n++] = component;
+  }
+
+  free(visited);
+  free(stack);
+
+  *numComponents = n;
+  return components;
+}
+
 // Graph
 
 int GraphIsDigraph(const Graph* g) { return g->isDigraph; }
@@ -371,6 +587,8 @@ int GraphAddVertex(Graph* g, unsigned int new_v) {
     return 0;
   }
 
+  _GraphThaw(g);
+
   // One more vertex
   g->numVertices++;
 
@@ -387,11 +605,90 @@ int GraphAddVertex(Graph* g, unsigned int new_v) {
   v->edgesList = ListCreate(graphEdgesComparator);
 
   // Add to the vertices list
-  ListInsert(g->verticesList, v);
+  v->node = ListInsertGetNode(g->verticesList, v);
+  g->vertexIndex[new_v] = v;
 
   return 1;
 }
 
+//
+// Remove the edge to w from the edges list of vertex, if there is one
+// The edges list is searched only up to w, as it is sorted
+//
+static int _removeAdjacent(struct _Vertex* vertex, unsigned int w) {
+  struct _Edge key = {w, 0.0};
+  if (ListSearch(vertex->edgesList, &key) == -1) {
+    return 0;
+  }
+  free(ListRemoveCurrent(vertex->edgesList));
+  vertex->outDegree--;
+  return 1;
+}
+
+//
+// The vertex data is found through the vertex index, and removed from the
+// vertices list through its node: only the edges lists of its adjacents
+// (and, for a digraph, of the vertices with edges into it) are searched
+//
+int GraphRemoveVertex(Graph* g, unsigned int v) {
+  assert(v < g->indicesRange);
+
+  if (IndicesSetContains(g->verticesSet, v) == 0) {
+    return 0;
+  }
+
+  _GraphThaw(g);
+  struct _Vertex* vertex = _getVertex(g, v);
+
+  // Its edges, and for a graph, the same edges in the other direction
+  List* edges = vertex->edgesList;
+  while (ListIsEmpty(edges) == 0) {
+    struct _Edge* e = ListRemoveHead(edges);
+    struct _Vertex* w = _getVertex(g, e->adjVertex);
+    if (g->isDigraph) {
+      w->inDegree--;
+    } else {
+      _removeAdjacent(w, v);
+    }
+    free(e);
+    g->numEdges--;
+  }
+
+  // For a digraph, the edges into v
+  List* vertices = g->verticesList;
+  if (g->isDigraph && vertex->inDegree > 0) {
+    ListMoveToHead(vertices);
+    unsigned int i = 0;
+    for (; i < g->numVertices && vertex->inDegree > 0;
+         ListMoveToNext(vertices), i++) {
+      struct _Vertex* u = ListGetCurrentItem(vertices);
+      if (_removeAdjacent(u, v)) {
+        vertex->inDegree--;
+        g->numEdges--;
+      }
+    }
+  }
+
+  ListRemoveNode(vertices, vertex->node);
+  ListDestroy(&(vertex->edgesList));
+  free(vertex);
+
+  g->vertexIndex[v] = NULL;
+  IndicesSetRemove(g->verticesSet, v);
+  g->numVertices--;
+
+  // Still complete, if it was; and it may now be, if v had missing edges
+  unsigned int n = g->numVertices;
+  unsigned int numComplete = g->isDigraph ? n * (n - 1) : n * (n - 1) / 2;
+  g->isComplete = (g->numEdges == numComplete);
+
+  return 1;
+}
+
+int GraphContainsVertex(const Graph* g, unsigned int v) {
+  return v < g->indicesRange && g->vertexIndex[v] != NULL;
+}
+
 //
 // returns the set of vertices
 // as a set of vertex indices
@@ -410,15 +707,12 @@ IndicesSet* GraphGetSetVertices(const Graph* g) {
 // as a set of vertex indices
 //
 IndicesSet* GraphGetSetAdjacentsTo(const Graph* g, unsigned int v) {
-  assert(IndicesSetContains(g->verticesSet, (uint16_t)v));
+  assert(IndicesSetContains(g->verticesSet, v));
 
   IndicesSet* adjacents_set = IndicesSetCreateEmpty(g->indicesRange);
 
-  // Find the vertex in the vertices list
-  struct _Vertex search_dummy;
-  search_dummy.id = v;
-  ListSearch(g->verticesList, (void*)(&search_dummy));
-  struct _Vertex* vertex = ListGetCurrentItem(g->verticesList);
+  // The vertex data, directly from the vertex index
+  struct _Vertex* vertex = _getVertex(g, v);
 
   // Iterate through the edges list and add each adjacent vertex to the set
   List* edges = vertex->edgesList;
@@ -433,6 +727,19 @@ IndicesSet* GraphGetSetAdjacentsTo(const Graph* g, unsigned int v) {
   return adjacents_set;
 }
 
+int GraphAdjacentsIterFirst(GraphAdjacentsIter* it, const Graph* g,
+                            unsigned int v) {
+  struct _Vertex* vertex = _getVertex(g, v);
+
+  const struct _Edge* edge = ListIterFirst(&(it->edges), vertex->edgesList);
+  return (edge == NULL) ? -1 : (int)edge->adjVertex;
+}
+
+int GraphAdjacentsIterNext(GraphAdjacentsIter* it) {
+  const struct _Edge* edge = ListIterNext(&(it->edges));
+  return (edge == NULL) ? -1 : (int)edge->adjVertex;
+}
+
 //
 // TO BE COMPLETED
 //
@@ -453,30 +760,23 @@ double* GraphComputeVertexWeights(const Graph* g) {
   }
 
   // Iterate through all vertices in the graph
-  List* vertices = g->verticesList;
-  if (!ListIsEmpty(vertices)) {
-    ListMoveToHead(vertices);
-    for (unsigned int i = 0; i < g->numVertices; i++, ListMoveToNext(vertices)) {
-      struct _Vertex* vertex = ListGetCurrentItem(vertices);
-      unsigned int vid = vertex->id;
-      
-      double weight = 0.0;
-      List* edges = vertex->edgesList;
-      
-      if (!ListIsEmpty(edges)) {
-        ListMoveToHead(edges);
-        for (int j = 0; j < ListGetSize(edges); j++, ListMoveToNext(edges)) {
-          struct _Edge* edge = ListGetCurrentItem(edges);
-          if (g->isWeighted) {
-            weight += edge->weight;
-          } else {
-            weight += 1.0;  // Count each edge as weight 1
-          }
-        }
+  const GraphCSR* c = GraphFreeze(g);
+  const uint32_t* vertices = GraphCSRGetVertices(c);
+  for (unsigned int i = 0; i < g->numVertices; i++) {
+    unsigned int vid = vertices[i];
+    unsigned int degree = GraphCSRGetDegree(c, vid);
+
+    double weight = 0.0;
+    if (g->isWeighted) {
+      const double* edgeWeights = GraphCSRGetWeights(c, vid);
+      for (unsigned int k = 0; k < degree; k++) {
+        weight += edgeWeights[k];
       }
-      
-      weightsArray[vid] = weight;
+    } else {
+      weight = (double)degree;  // Count each edge as weight 1
     }
+
+    weightsArray[vid] = weight;
   }
 
   return weightsArray;
@@ -489,10 +789,7 @@ unsigned int GraphGetVertexDegree(Graph* g, unsigned int v) {
   assert(g->isDigraph == 0);
   assert(IndicesSetContains(g->verticesSet, v));
 
-  struct _Vertex search_dummy;
-  search_dummy.id = v;
-  ListSearch(g->verticesList, (void*)(&search_dummy));
-  struct _Vertex* p = ListGetCurrentItem(g->verticesList);
+  struct _Vertex* p = _getVertex(g, v);
 
   return p->outDegree;
 }
@@ -504,10 +801,7 @@ unsigned int GraphGetVertexOutDegree(Graph* g, unsigned int v) {
   assert(g->isDigraph == 1);
   assert(IndicesSetContains(g->verticesSet, v));
 
-  struct _Vertex search_dummy;
-  search_dummy.id = v;
-  ListSearch(g->verticesList, (void*)(&search_dummy));
-  struct _Vertex* p = ListGetCurrentItem(g->verticesList);
+  struct _Vertex* p = _getVertex(g, v);
 
   return p->outDegree;
 }
@@ -519,10 +813,7 @@ unsigned int GraphGetVertexInDegree(Graph* g, unsigned int v) {
   assert(g->isDigraph == 1);
   assert(IndicesSetContains(g->verticesSet, v));
 
-  struct _Vertex search_dummy;
-  search_dummy.id = v;
-  ListSearch(g->verticesList, (void*)(&search_dummy));
-  struct _Vertex* p = ListGetCurrentItem(g->verticesList);
+  struct _Vertex* p = _getVertex(g, v);
 
   return p->inDegree;
 }
@@ -536,10 +827,7 @@ static int _addEdge(Graph* g, unsigned int v, unsigned int w, double weight) {
   edge_v_w->adjVertex = w;
   edge_v_w->weight = weight;
 
-  struct _Vertex search_dummy;
-  search_dummy.id = v;
-  ListSearch(g->verticesList, (void*)(&search_dummy));
-  struct _Vertex* vertex_v = ListGetCurrentItem(g->verticesList);
+  struct _Vertex* vertex_v = _getVertex(g, v);
   int result = ListInsert(vertex_v->edgesList, edge_v_w);
 
   if (result == -1) {
@@ -552,9 +840,7 @@ static int _addEdge(Graph* g, unsigned int v, unsigned int w, double weight) {
   g->numEdges++;
   vertex_v->outDegree++;
 
-  search_dummy.id = w;
-  ListSearch(g->verticesList, (void*)(&search_dummy));
-  struct _Vertex* vertex_w = ListGetCurrentItem(g->verticesList);
+  struct _Vertex* vertex_w = _getVertex(g, w);
   // DIRECTED GRAPH --- Update the in-degree of vertex w
   if (g->isDigraph == 1) {
     vertex_w->inDegree++;
@@ -593,6 +879,8 @@ static int _addEdge(Graph* g, unsigned int v, unsigned int w, double weight) {
     }
   }
 
+  _GraphThaw(g);
+
   return 1;
 }
 
@@ -615,6 +903,126 @@ int GraphAddWeightedEdge(Graph* g, unsigned int v, unsigned int w,
   return _addEdge(g, v, w, weight);
 }
 
+int GraphRemoveEdge(Graph* g, unsigned int v, unsigned int w) {
+  assert(IndicesSetContains(g->verticesSet, v));
+  assert(IndicesSetContains(g->verticesSet, w));
+
+  struct _Vertex* vertex_v = _getVertex(g, v);
+  struct _Vertex* vertex_w = _getVertex(g, w);
+  if (_removeAdjacent(vertex_v, w) == 0) {
+    return 0;
+  }
+
+  if (g->isDigraph) {
+    vertex_w->inDegree--;
+  } else {
+    _removeAdjacent(vertex_w, v);
+  }
+  g->numEdges--;
+  g->isComplete = 0;
+
+  _GraphThaw(g);
+
+  return 1;
+}
+
+// FROZEN SNAPSHOT
+
+const GraphCSR* GraphFreeze(const Graph* g) {
+  assert(g != NULL);
+
+  if (g->frozen != NULL) {
+    return g->frozen;
+  }
+
+  GraphCSR* c = (GraphCSR*)malloc(sizeof(struct _GraphCSR));
+  if (c == NULL) abort();
+
+  c->indicesRange = g->indicesRange;
+  c->numVertices = g->numVertices;
+
+  unsigned int total = 0;  // Number of entries in the adjacency array
+  List* vertices = g->verticesList;
+  ListMoveToHead(vertices);
+  for (unsigned int i = 0; i < g->numVertices; ListMoveToNext(vertices), i++) {
+    struct _Vertex* v = ListGetCurrentItem(vertices);
+    total += v->outDegree;
+  }
+
+  c->vertices = (uint32_t*)malloc(g->numVertices * sizeof(uint32_t));
+  c->offsets = (uint32_t*)malloc((g->indicesRange + 1) * sizeof(uint32_t));
+  c->adjacents = (uint32_t*)malloc(total * sizeof(uint32_t));
+  c->weights = NULL;
+  if (g->isWeighted) {
+    c->weights = (double*)malloc(total * sizeof(double));
+  }
+  if (c->vertices == NULL || c->offsets == NULL ||
+      (total > 0 && c->adjacents == NULL) ||
+      (g->isWeighted && total > 0 && c->weights == NULL)) {
+    abort();
+  }
+
+  // The vertices list is sorted by index: the offsets of the missing
+  // indices are filled on the way, so that their degree is 0
+  unsigned int next = 0;  // Position of the next adjacent
+  unsigned int u = 0;     // Next index without offset
+  ListMoveToHead(vertices);
+  for (unsigned int i = 0; i < g->numVertices; ListMoveToNext(vertices), i++) {
+    struct _Vertex* v = ListGetCurrentItem(vertices);
+    c->vertices[i] = v->id;
+    for (; u <= v->id; u++) {
+      c->offsets[u] = next;
+    }
+
+    // The edges lists are sorted by adjacent vertex
+    List* edges = v->edgesList;
+    ListMoveToHead(edges);
+    for (unsigned int k = 0; k < v->outDegree; ListMoveToNext(edges), k++) {
+      struct _Edge* e = ListGetCurrentItem(edges);
+      c->adjacents[next] = e->adjVertex;
+      if (c->weights != NULL) {
+        c->weights[next] = e->weight;
+      }
+      next++;
+    }
+  }
+  for (; u <= g->indicesRange; u++) {
+    c->offsets[u] = next;
+  }
+  assert(next == total);
+
+  // Cached in the (logically constant) graph, until it is modified
+  ((Graph*)g)->frozen = c;
+
+  return c;
+}
+
+unsigned int GraphCSRGetVertexRange(const GraphCSR* c) {
+  return c->indicesRange;
+}
+
+unsigned int GraphCSRGetNumVertices(const GraphCSR* c) {
+  return c->numVertices;
+}
+
+const uint32_t* GraphCSRGetVertices(const GraphCSR* c) { return c->vertices; }
+
+unsigned int GraphCSRGetDegree(const GraphCSR* c, unsigned int v) {
+  assert(v < c->indicesRange);
+  return c->offsets[v + 1] - c->offsets[v];
+}
+
+const uint32_t* GraphCSRGetAdjacents(const GraphCSR* c, unsigned int v) {
+  assert(v < c->indicesRange);
+  return c->adjacents + c->offsets[v];
+}
+
+const double* GraphCSRGetWeights(const GraphCSR* c, unsigned int v) {
+  assert(v < c->indicesRange);
+  if (c->weights == NULL) return NULL;
+  return c->weights + c->offsets[v];
+}
+
 // CHECKING
 
 int GraphCheckInvariants(const Graph* g) {
@@ -625,7 +1033,6 @@ int GraphCheckInvariants(const Graph* g) {
   assert(g->isWeighted == 0 || g->isWeighted == 1);
 
   if (g->isComplete) {
-    assert(g->indicesRange == g->numVertices);
     unsigned int n = g->numVertices;
     if (g->isDigraph) {
       assert(g->numEdges == n * (n - 1));
@@ -635,7 +1042,7 @@ int GraphCheckInvariants(const Graph* g) {
   }
 
   assert((int)g->numVertices == ListGetSize(g->verticesList));
-  assert((int)g->numVertices == IndicesSetGetNumElems(g->verticesSet));
+  assert(g->numVertices == IndicesSetGetNumElems(g->verticesSet));
 
   // Checking the vertices list
   ListTestInvariants(g->verticesList);
@@ -15,6 +15,7 @@
 #include <stdio.h>
 
 #include "IndicesSet.h"
+#include "SortedList.h"
 
 typedef struct _GraphHeader Graph;
 
@@ -31,6 +32,15 @@ Graph* GraphFromFile(FILE* f);
 
 Graph* GraphGetSubgraph(const Graph* g, IndicesSet* vertSet);
 
+//
+// For a graph
+//
+// Returns an array with the vertex sets of the connected components,
+// in increasing order of their lowest vertex, and stores their number
+//
+IndicesSet** GraphGetConnectedComponents(const Graph* g,
+                                         unsigned int* numComponents);
+
 // Graph
 
 int GraphIsDigraph(const Graph* g);
@@ -64,10 +74,39 @@ unsigned int GraphGetMaxOutDegree(const Graph* g);
 
 int GraphAddVertex(Graph* g, unsigned int v);
 
+//
+// Removes vertex v and all its edges
+// Returns 1 on success, 0 if v is not a vertex
+//
+int GraphRemoveVertex(Graph* g, unsigned int v);
+
+//
+// Is v a vertex of the graph? In O(1)
+//
+int GraphContainsVertex(const Graph* g, unsigned int v);
+
 IndicesSet* GraphGetSetVertices(const Graph* g);
 
 IndicesSet* GraphGetSetAdjacentsTo(const Graph* g, unsigned int v);
 
+//
+// Iterate over the adjacents of vertex v, walking its edges list:
+// unlike GraphGetSetAdjacentsTo, nothing is allocated, and unlike the
+// frozen snapshot, nothing is rebuilt after the graph is modified
+// The graph must not be modified during the iteration
+//   GraphAdjacentsIter it;
+//   for (int w = GraphAdjacentsIterFirst(&it, g, v); w != -1;
+//        w = GraphAdjacentsIterNext(&it)) { ... }
+//
+typedef struct {
+  ListIter edges;
+} GraphAdjacentsIter;
+
+int GraphAdjacentsIterFirst(GraphAdjacentsIter* it, const Graph* g,
+                            unsigned int v);
+
+int GraphAdjacentsIterNext(GraphAdjacentsIter* it);
+
 double* GraphComputeVertexWeights(const Graph* g);
 
 //
@@ -92,6 +131,43 @@ int GraphAddEdge(Graph* g, unsigned int v, unsigned int w);
 int GraphAddWeightedEdge(Graph* g, unsigned int v, unsigned int w,
                          double weight);
 
+//
+// Removes the edge (v,w), in both directions for a graph
+// Returns 1 on success, 0 if there is no such edge
+//
+int GraphRemoveEdge(Graph* g, unsigned int v, unsigned int w);
+
+// FROZEN SNAPSHOT
+//
+// A read-only Compressed Sparse Row (CSR) view of the graph:
+// the adjacents of all vertices stored in a single contiguous array,
+// in increasing order, with the adjacents of vertex v in positions
+// offsets[v] .. offsets[v + 1] - 1.
+// Meant for algorithms that traverse the graph many times.
+//
+// The snapshot is owned by the graph, and built only once:
+// it remains valid until the graph is modified or destroyed.
+// Do NOT destroy it.
+
+typedef struct _GraphCSR GraphCSR;
+
+const GraphCSR* GraphFreeze(const Graph* g);
+
+unsigned int GraphCSRGetVertexRange(const GraphCSR* c);
+
+unsigned int GraphCSRGetNumVertices(const GraphCSR* c);
+
+// The vertex indices, in increasing order
+const uint32_t* GraphCSRGetVertices(const GraphCSR* c);
+
+// 0 if v is not a vertex
+unsigned int GraphCSRGetDegree(const GraphCSR* c, unsigned int v);
+
+const uint32_t* GraphCSRGetAdjacents(const GraphCSR* c, unsigned int v);
+
+// The weights of the edges to the adjacents, or NULL if not weighted
+const double* GraphCSRGetWeights(const GraphCSR* c, unsigned int v);
+
 // CHECKING
 
 int GraphCheckInvariants(const Graph* g);
@@ -18,13 +18,28 @@
 #include "GraphDominatingSets.h"
 
 #include <assert.h>
+#include <float.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#ifdef BNB_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
+#include "DominationChecker.h"
 #include "Graph.h"
 #include "IndicesSet.h"
 #include "instrumentation.h"
 
+// Built with BNB_THREADS (make THREADS=1), the branch-and-bound searches
+// run on a pool of threads: the variables they share are atomic
+#ifdef BNB_THREADS
+#define BNB_ATOMIC _Atomic
+#else
+#define BNB_ATOMIC
+#endif
+
 //
 // TO BE COMPLETED
 //
@@ -39,61 +54,225 @@ int GraphIsDominatingSet(const Graph* g, IndicesSet* vertSet) {
   assert(GraphIsDigraph(g) == 0);
   assert(IndicesSetIsEmpty(vertSet) == 0);
 
-  // Get all vertices in the graph
-  IndicesSet* allVertices = GraphGetSetVertices(g);
-  
-  // Create a set of vertices that are either in vertSet or adjacent to it
-  IndicesSet* dominated = IndicesSetCreateCopy(vertSet);
-  
-  // For each vertex in the dominating set, add its neighbors
-  int v = IndicesSetGetFirstElem(vertSet);
+  // Mark the vertices that are either in vertSet or adjacent to it,
+  // using the frozen (CSR) adjacency arrays of the graph
+  const GraphCSR* c = GraphFreeze(g);
+  unsigned int range = GraphCSRGetVertexRange(c);
+  char* dominated = calloc(range, sizeof(char));
+  if (dominated == NULL) abort();
+
+  IndicesSetIter it;
+  int v = IndicesSetIterFirst(&it, vertSet);
   while (v != -1) {
-    IndicesSet* adjacents = GraphGetSetAdjacentsTo(g, (unsigned int)v);
-    IndicesSetUnion(dominated, adjacents);
-    IndicesSetDestroy(&adjacents);
-    v = IndicesSetGetNextElem(vertSet);
+    dominated[v] = 1;
+    unsigned int degree = GraphCSRGetDegree(c, (unsigned int)v);
+    const uint32_t* adjacents = GraphCSRGetAdjacents(c, (unsigned int)v);
+    for (unsigned int k = 0; k < degree; k++) {
+      dominated[adjacents[k]] = 1;
+    }
+    v = IndicesSetIterNext(&it);
   }
-  
+
   // Check if all vertices are dominated
-  int result = IndicesSetIsSubset(allVertices, dominated);
-  
-  IndicesSetDestroy(&allVertices);
-  IndicesSetDestroy(&dominated);
+  int result = 1;
+  unsigned int numVertices = GraphCSRGetNumVertices(c);
+  const uint32_t* vertices = GraphCSRGetVertices(c);
+  for (unsigned int i = 0; i < numVertices && result; i++) {
+    result = dominated[vertices[i]];
+  }
+
+  free(dominated);
 
   return result;
 }
 
 //
-// TO BE COMPLETED
+// GREEDY heuristic for a VERTEX DOMINATING SET
 //
-// Compute a MIN VERTEX DOMINATING SET of the graph
-// using an EXHAUSTIVE SEARCH approach
-// Return the/a dominating set
+// The gain of a vertex is the number of undominated vertices in its
+// closed neighbourhood. The vertices are kept in buckets, one for each
+// gain; gains only decrease, so a vertex is not moved when its gain
+// changes: when taken from a bucket with an outdated gain, it is just put
+// back in the bucket of its current gain. The gains decrease, at most,
+// V + 2E times in total, so everything is O(V + E).
 //
-IndicesSet* GraphComputeMinDominatingSet(const Graph* g) {
+IndicesSet* GraphComputeGreedyDominatingSet(const Graph* g) {
   assert(g != NULL);
   assert(GraphIsDigraph(g) == 0);
 
   unsigned int range = GraphGetVertexRange(g);
-  unsigned int numVertices = GraphGetNumVertices(g);
+  const GraphCSR* c = GraphFreeze(g);
+  unsigned int numVertices = GraphCSRGetNumVertices(c);
+  const uint32_t* vertices = GraphCSRGetVertices(c);
+  unsigned int maxGain = GraphGetMaxDegree(g) + 1;
+
+  unsigned int* gain = malloc(range * sizeof(unsigned int));
+  char* dominated = calloc(range, sizeof(char));
+  // The buckets are stacks, linked through next
+  int* head = malloc((maxGain + 1) * sizeof(int));
+  int* next = malloc(range * sizeof(int));
+  if (gain == NULL || dominated == NULL || head == NULL || next == NULL) {
+    abort();
+  }
+
+  for (unsigned int k = 0; k <= maxGain; k++) head[k] = -1;
+  // In reverse order, so that each bucket starts sorted by vertex index;
+  // the vertices put back later go to its top, so ties are not broken by index
+  for (unsigned int i = numVertices; i-- > 0;) {
+    unsigned int v = vertices[i];
+    gain[v] = GraphCSRGetDegree(c, v) + 1;
+    next[v] = head[gain[v]];
+    head[gain[v]] = (int)v;
+  }
+
+  IndicesSet* set = IndicesSetCreateEmpty(range);
+  unsigned int undominated = numVertices;
+  unsigned int k = maxGain;
+  while (undominated > 0) {
+    // Highest non-empty bucket (there is one: undominated vertices
+    // have gain at least 1)
+    while (head[k] == -1) k--;
+    unsigned int v = (unsigned int)head[k];
+    head[k] = next[v];
+
+    if (gain[v] != k) {
+      // Outdated: back in its current bucket
+      next[v] = head[gain[v]];
+      head[gain[v]] = (int)v;
+      continue;
+    }
+
+    IndicesSetAdd(set, v);
+    gain[v] = 0;
+
+    // The vertices of N[v] that become dominated decrease the gains of
+    // their own closed neighbourhoods
+    unsigned int degree = GraphCSRGetDegree(c, v);
+    const uint32_t* adjacents = GraphCSRGetAdjacents(c, v);
+    for (unsigned int j = 0; j <= degree; j++) {
+      unsigned int x = (j == degree) ? v : adjacents[j];
+      if (dominated[x]) continue;
+      dominated[x] = 1;
+      undominated--;
+
+      if (gain[x] > 0) gain[x]--;
+      unsigned int degreeX = GraphCSRGetDegree(c, x);
+      const uint32_t* adjacentsX = GraphCSRGetAdjacents(c, x);
+      for (unsigned int l = 0; l < degreeX; l++) {
+        if (gain[adjacentsX[l]] > 0) gain[adjacentsX[l]]--;
+      }
+    }
+  }
+
+  free(gain);
+  free(dominated);
+  free(head);
+  free(next);
+
+  return set;
+}
+
+//
+// Move the set of the checker to the next subset of the given vertices,
+// in binary table order, as IndicesSetNextSubset does for all indices,
+// updating the domination counts
+// Amortised O(1) additions / removals per subset
+// Starting the carry at the lowest element of the set, instead of at 0,
+// skips all the supersets that only add smaller elements
+// Return the position of the lowest element of the new subset,
+// or -1 if past the last subset (i.e., past the full set)
+//
+static int _NextSubset(DominationChecker* d, const uint32_t* vertices,
+                       unsigned int numVertices, unsigned int first) {
+  const IndicesSet* set = DominationCheckerGetSet(d);
+
+  unsigned int i = first;
+  while (i < numVertices && IndicesSetContains(set, vertices[i])) {
+    DominationCheckerRemove(d, vertices[i]);
+    i++;
+  }
+
+  if (i < numVertices) {
+    DominationCheckerAdd(d, vertices[i]);
+    return (int)i;
+  }
+
+  /* Overflow */
+  return -1;
+}
+
+//
+// Solve each connected component on its own, and join the results:
+// the cost is the sum, and not the product, of the costs of the
+// components
+// The first minimum set in binary table order is the union of the first
+// ones of each component, so the result is the same
+//
+static IndicesSet* _SolveByComponents(const Graph* g,
+                                      IndicesSet* (*solve)(const Graph*)) {
+  unsigned int numComponents;
+  IndicesSet** components = GraphGetConnectedComponents(g, &numComponents);
+
+  IndicesSet* result;
+  if (numComponents <= 1) {
+    result = solve(g);
+  } else {
+    result = IndicesSetCreateEmpty(GraphGetVertexRange(g));
+    for (unsigned int i = 0; i < numComponents; i++) {
+      Graph* component = GraphGetSubgraph(g, components[i]);
+      IndicesSet* componentResult = solve(component);
+      IndicesSetUnion(result, componentResult);
+      IndicesSetDestroy(&componentResult);
+      GraphDestroy(&component);
+    }
+  }
+
+  for (unsigned int i = 0; i < numComponents; i++) {
+    IndicesSetDestroy(&components[i]);
+  }
+  free(components);
+
+  return result;
+}
+
+//
+// The candidate subsets are visited in binary table order, keeping the
+// domination counts up to date: each check is O(1)
+// Sets larger than the greedy dominating set, or than the smallest one
+// found so far, are skipped with all the supersets that follow them
+//
+static IndicesSet* _MinDominatingSet(const Graph* g) {
+  unsigned int range = GraphGetVertexRange(g);
+  const GraphCSR* c = GraphFreeze(g);
+  unsigned int numVertices = GraphCSRGetNumVertices(c);
+  const uint32_t* vertices = GraphCSRGetVertices(c);
   
   // Start with an empty set and iterate through all possible subsets
-  IndicesSet* candidate = IndicesSetCreateEmpty(range);
+  DominationChecker* d = DominationCheckerCreate(g);
+  const IndicesSet* candidate = DominationCheckerGetSet(d);
   IndicesSet* result = NULL;
-  unsigned int minSize = numVertices + 1;  // Initialize with a value larger than possible
+  // A minimum dominating set is not larger than the greedy one
+  IndicesSet* greedy = GraphComputeGreedyDominatingSet(g);
+  unsigned int minSize = IndicesSetGetNumElems(greedy) + 1;
+  IndicesSetDestroy(&greedy);
+  assert(minSize <= numVertices + 1);
   
   // Iterate through all possible subsets in binary table order
   // Start with empty set (already created)
+  int lowest = 0;  // Position of the lowest element of the candidate
   do {
+    unsigned int first = 0;
     // Check if candidate has any elements and is a dominating set
     if (!IndicesSetIsEmpty(candidate)) {
-      InstrCount[0]++;  // Count dominating set checks
-      
-      if (GraphIsDominatingSet(g, candidate)) {
-        unsigned int candidateSize = IndicesSetGetNumElems(candidate);
-        
-        // If this is the smallest dominating set so far, save it
-        if (candidateSize < minSize) {
+      unsigned int candidateSize = IndicesSetGetNumElems(candidate);
+      if (candidateSize >= minSize) {
+        // Too large, and so are the supersets that follow
+        first = (unsigned int)lowest;
+      } else {
+        InstrCount[0]++;  // Count dominating set checks
+
+        if (DominationCheckerIsDominating(d)) {
+          // The smallest dominating set so far: save it
           minSize = candidateSize;
           if (result != NULL) {
             IndicesSetDestroy(&result);
@@ -102,9 +281,10 @@ IndicesSet* GraphComputeMinDominatingSet(const Graph* g) {
         }
       }
     }
-  } while (IndicesSetNextSubset(candidate));
+    lowest = _NextSubset(d, vertices, numVertices, first);
+  } while (lowest != -1);
   
-  IndicesSetDestroy(&candidate);
+  DominationCheckerDestroy(&d);
   
   // If no dominating set was found, return empty set
   if (result == NULL) {
@@ -117,21 +297,29 @@ IndicesSet* GraphComputeMinDominatingSet(const Graph* g) {
 //
 // TO BE COMPLETED
 //
-// Compute a MIN WEIGHT VERTEX DOMINATING SET of the graph
-// using an EXHAUSTIVE SEARCH approach
-// Return the dominating set
+// Compute a MIN VERTEX DOMINATING SET of the graph
+// using an EXHAUSTIVE SEARCH approach, on each connected component
+// Return the/a dominating set
 //
-IndicesSet* GraphComputeMinWeightDominatingSet(const Graph* g) {
+IndicesSet* GraphComputeMinDominatingSet(const Graph* g) {
   assert(g != NULL);
   assert(GraphIsDigraph(g) == 0);
 
+  return _SolveByComponents(g, _MinDominatingSet);
+}
+
+static IndicesSet* _MinWeightDominatingSet(const Graph* g) {
   unsigned int range = GraphGetVertexRange(g);
+  const GraphCSR* c = GraphFreeze(g);
+  unsigned int numVertices = GraphCSRGetNumVertices(c);
+  const uint32_t* vertices = GraphCSRGetVertices(c);
   
   // Get the weights of all vertices
   double* weights = GraphComputeVertexWeights(g);
   
   // Start with an empty set and iterate through all possible subsets
-  IndicesSet* candidate = IndicesSetCreateEmpty(range);
+  DominationChecker* d = DominationCheckerCreate(g);
+  const IndicesSet* candidate = DominationCheckerGetSet(d);
   IndicesSet* result = NULL;
   double minWeight = -1.0;  // -1.0 means no valid set found yet
   
@@ -141,13 +329,14 @@ IndicesSet* GraphComputeMinWeightDominatingSet(const Graph* g) {
     if (!IndicesSetIsEmpty(candidate)) {
       InstrCount[1]++;  // Count dominating set checks
       
-      if (GraphIsDominatingSet(g, candidate)) {
+      if (DominationCheckerIsDominating(d)) {
         // Calculate the total weight of this dominating set
         double candidateWeight = 0.0;
-        int v = IndicesSetGetFirstElem(candidate);
+        IndicesSetIter it;
+        int v = IndicesSetIterFirst(&it, candidate);
         while (v != -1) {
           candidateWeight += weights[v];
-          v = IndicesSetGetNextElem(candidate);
+          v = IndicesSetIterNext(&it);
         }
         
         // If this is the smallest weight dominating set so far, save it
@@ -160,9 +349,9 @@ IndicesSet* GraphComputeMinWeightDominatingSet(const Graph* g) {
         }
       }
     }
-  } while (IndicesSetNextSubset(candidate));
+  } while (_NextSubset(d, vertices, numVertices, 0) != -1);
   
-  IndicesSetDestroy(&candidate);
+  DominationCheckerDestroy(&d);
   free(weights);
   
   // If no dominating set was found, return empty set
@@ -172,3 +361,1635 @@ IndicesSet* GraphComputeMinWeightDominatingSet(const Graph* g) {
 
   return result;
 }
+
+//
+// TO BE COMPLETED
+//
+// Compute a MIN WEIGHT VERTEX DOMINATING SET of the graph
+// using an EXHAUSTIVE SEARCH approach, on each connected component
+// Return the dominating set
+//
+IndicesSet* GraphComputeMinWeightDominatingSet(const Graph* g) {
+  assert(g != NULL);
+  assert(GraphIsDigraph(g) == 0);
+
+  return _SolveByComponents(g, _MinWeightDominatingSet);
+}
+
+//
+// LIMITS of the ANYTIME search
+//
+// They are checked by the reduction rules and by the search, and every
+// step taken after they are reached returns at once. Reading the clock is
+// not free, so it is read only after about BNB_CLOCK_WORK vertex visits:
+// the steps count their work, and not just their number, so that the
+// clock is read as often on a large graph as on a small one.
+//
+
+#define BNB_CLOCK_WORK (1UL << 14)
+
+typedef struct {
+  const DominatingSetSearchOptions* options;  // NULL, if no limits
+  double deadline;
+  BNB_ATOMIC unsigned long numNodes;  // Search nodes visited
+  BNB_ATOMIC unsigned long work;  // Vertex visits since the clock was read
+  BNB_ATOMIC int stopped;
+} _SearchLimits;
+
+// Add nodes to the search nodes visited, and work to the vertex visits
+// Return 1 if the limits of the options were reached
+static int _LimitReached(_SearchLimits* l, unsigned int nodes,
+                         unsigned long work) {
+  if (l == NULL || l->options == NULL) return 0;
+  if (l->stopped) return 1;
+
+  l->numNodes += nodes;
+  if (l->options->nodeLimit > 0 && l->numNodes > l->options->nodeLimit) {
+    l->stopped = 1;
+  }
+  l->work += work;
+  if (l->options->timeLimit > 0.0 && l->work >= BNB_CLOCK_WORK) {
+    l->work = 0;
+    if (wall_time() > l->deadline) l->stopped = 1;
+  }
+  return l->stopped;
+}
+
+//
+// REDUCTION rules for the MIN VERTEX DOMINATING SET problem
+//
+// The problem is seen as covering the required vertices (initially, all)
+// with the closed neighbourhoods of the candidate vertices (initially,
+// all). The rules are applied until none applies:
+//  - a required vertex with a single candidate dominator forces it into
+//    the set, and the vertices it dominates are no longer required
+//    (e.g., the neighbour of a degree-1 vertex);
+//  - a required vertex u is no longer required when another required
+//    vertex has all its candidate dominators among those of u: whatever
+//    dominates the other one also dominates u;
+//  - a candidate a is excluded when another candidate b dominates all
+//    the required vertices that a dominates: a can always be replaced by
+//    b (this merges twins, keeping the one with the lowest index, and
+//    excludes the candidates that dominate no required vertex).
+// A minimum dominating set is then given by the forced vertices, plus a
+// minimum set of candidates that dominates the required vertices.
+//
+
+typedef struct {
+  const GraphCSR* csr;
+  DominationChecker* d;  // The forced vertices
+  char* excluded;        // Vertices that are not candidates
+  char* required;
+  unsigned int* mark;
+  unsigned int stamp;
+  _SearchLimits* limits;  // NULL, if no limits
+} _Reduction;
+
+static int _IsRequired(const _Reduction* r, unsigned int v) {
+  return r->required[v] && DominationCheckerGetCount(r->d, v) == 0;
+}
+
+// Mark the candidate dominators of u (with a new stamp)
+// Return how many, and the last one in w
+static unsigned int _MarkCandidates(_Reduction* r, unsigned int u,
+                                    unsigned int* w) {
+  r->stamp++;
+  unsigned int n = 0;
+  unsigned int degree = GraphCSRGetDegree(r->csr, u);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(r->csr, u);
+  for (unsigned int k = 0; k <= degree; k++) {
+    unsigned int x = (k == degree) ? u : adjacents[k];
+    if (r->excluded[x]) continue;
+    r->mark[x] = r->stamp;
+    *w = x;
+    n++;
+  }
+  return n;
+}
+
+// Are all candidate dominators of v marked?
+// Return how many there are, or 0 if some is not marked
+static unsigned int _CandidatesMarked(const _Reduction* r, unsigned int v) {
+  unsigned int n = 0;
+  unsigned int degree = GraphCSRGetDegree(r->csr, v);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(r->csr, v);
+  for (unsigned int k = 0; k <= degree; k++) {
+    unsigned int x = (k == degree) ? v : adjacents[k];
+    if (r->excluded[x]) continue;
+    if (r->mark[x] != r->stamp) return 0;
+    n++;
+  }
+  return n;
+}
+
+// Mark the required vertices dominated by a (with a new stamp)
+// Return how many, and the last one in u
+static unsigned int _MarkRequired(_Reduction* r, unsigned int a,
+                                  unsigned int* u) {
+  r->stamp++;
+  unsigned int n = 0;
+  unsigned int degree = GraphCSRGetDegree(r->csr, a);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(r->csr, a);
+  for (unsigned int k = 0; k <= degree; k++) {
+    unsigned int x = (k == degree) ? a : adjacents[k];
+    if (!_IsRequired(r, x)) continue;
+    r->mark[x] = r->stamp;
+    *u = x;
+    n++;
+  }
+  return n;
+}
+
+// Are all required vertices dominated by b marked?
+// Return how many marked ones b dominates (*numRequired, all of them)
+static unsigned int _CountMarked(const _Reduction* r, unsigned int b,
+                                 unsigned int* numRequired) {
+  unsigned int n = 0;
+  *numRequired = 0;
+  unsigned int degree = GraphCSRGetDegree(r->csr, b);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(r->csr, b);
+  for (unsigned int k = 0; k <= degree; k++) {
+    unsigned int x = (k == degree) ? b : adjacents[k];
+    if (!_IsRequired(r, x)) continue;
+    (*numRequired)++;
+    n += (r->mark[x] == r->stamp);
+  }
+  return n;
+}
+
+// Apply the rules to the required vertex u
+// Return 1 if something changed
+static int _ReduceRequired(_Reduction* r, unsigned int u) {
+  unsigned int w = u;
+  unsigned int numCand = _MarkCandidates(r, u, &w);
+  assert(numCand > 0);
+  if (numCand == 1) {
+    DominationCheckerAdd(r->d, w);
+    r->excluded[w] = 1;
+    return 1;
+  }
+
+  // Another required vertex, with all its candidates among those of u,
+  // is in the closed neighbourhood of one of them
+  unsigned int degree = GraphCSRGetDegree(r->csr, u);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(r->csr, u);
+  for (unsigned int k = 0; k <= degree; k++) {
+    unsigned int c = (k == degree) ? u : adjacents[k];
+    if (r->excluded[c]) continue;
+
+    unsigned int degreeC = GraphCSRGetDegree(r->csr, c);
+    const uint32_t* adjacentsC = GraphCSRGetAdjacents(r->csr, c);
+    for (unsigned int l = 0; l <= degreeC; l++) {
+      unsigned int v = (l == degreeC) ? c : adjacentsC[l];
+      if (v == u || !_IsRequired(r, v)) continue;
+      unsigned int vNumCand = _CandidatesMarked(r, v);
+      if (vNumCand == 0) continue;
+
+      // With the same candidates, only the one with the lowest index stays
+      if (vNumCand < numCand || v < u) {
+        r->required[u] = 0;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// Apply the rules to the candidate a
+// Return 1 if something changed
+static int _ReduceCandidate(_Reduction* r, unsigned int a) {
+  unsigned int u = a;
+  unsigned int numRequired = _MarkRequired(r, a, &u);
+  if (numRequired == 0) {
+    r->excluded[a] = 1;
+    return 1;
+  }
+
+  // Another candidate, dominating all that a dominates, dominates u
+  unsigned int degree = GraphCSRGetDegree(r->csr, u);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(r->csr, u);
+  for (unsigned int k = 0; k <= degree; k++) {
+    unsigned int b = (k == degree) ? u : adjacents[k];
+    if (b == a || r->excluded[b]) continue;
+    unsigned int bNumRequired;
+    if (_CountMarked(r, b, &bNumRequired) < numRequired) continue;
+
+    // With the same required vertices, only the one with the lowest
+    // index stays
+    if (bNumRequired > numRequired || b < a) {
+      r->excluded[a] = 1;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// The rules applied to v visit about (degree + 1)^2 vertices
+static unsigned long _ReduceWork(const _Reduction* r, unsigned int v) {
+  unsigned long degree = GraphCSRGetDegree(r->csr, v) + 1;
+  return degree * degree;
+}
+
+static void _Reduce(_Reduction* r) {
+  unsigned int numVertices = GraphCSRGetNumVertices(r->csr);
+  const uint32_t* vertices = GraphCSRGetVertices(r->csr);
+
+  int changed = 1;
+  while (changed) {
+    changed = 0;
+    for (unsigned int i = 0; i < numVertices; i++) {
+      unsigned int v = vertices[i];
+      if (_IsRequired(r, v)) changed |= _ReduceRequired(r, v);
+      if (_LimitReached(r->limits, 0, _ReduceWork(r, v))) break;
+    }
+    for (unsigned int i = 0; i < numVertices; i++) {
+      unsigned int v = vertices[i];
+      if (!r->excluded[v]) changed |= _ReduceCandidate(r, v);
+      if (_LimitReached(r->limits, 0, _ReduceWork(r, v))) break;
+    }
+    // Stopped: the rules applied so far are still valid
+    if (_LimitReached(r->limits, 0, 0)) break;
+  }
+
+  // The vertices dominated by the forced ones are no longer required
+  for (unsigned int i = 0; i < numVertices; i++) {
+    unsigned int v = vertices[i];
+    r->required[v] = _IsRequired(r, v);
+  }
+}
+
+DominationKernel* GraphReduceForDomination(const Graph* g) {
+  assert(g != NULL);
+  assert(GraphIsDigraph(g) == 0);
+
+  unsigned int range = GraphGetVertexRange(g);
+
+  _Reduction r;
+  r.csr = GraphFreeze(g);
+  r.d = DominationCheckerCreate(g);
+  r.excluded = calloc(range, sizeof(char));
+  r.required = malloc(range * sizeof(char));
+  r.mark = calloc(range, sizeof(unsigned int));
+  r.stamp = 0;
+  r.limits = NULL;
+  if (r.excluded == NULL || r.required == NULL || r.mark == NULL) abort();
+  memset(r.required, 1, range);
+
+  _Reduce(&r);
+
+  DominationKernel* k = malloc(sizeof(DominationKernel));
+  if (k == NULL) abort();
+  k->forced = IndicesSetCreateCopy(DominationCheckerGetSet(r.d));
+  k->required = IndicesSetCreateEmpty(range);
+  k->candidates = IndicesSetCreateEmpty(range);
+  unsigned int numVertices = GraphCSRGetNumVertices(r.csr);
+  const uint32_t* vertices = GraphCSRGetVertices(r.csr);
+  for (unsigned int i = 0; i < numVertices; i++) {
+    unsigned int v = vertices[i];
+    if (r.required[v]) IndicesSetAdd(k->required, v);
+    if (!r.excluded[v]) IndicesSetAdd(k->candidates, v);
+  }
+
+  IndicesSet* kernelVertices = IndicesSetCreateCopy(k->required);
+  IndicesSetUnion(kernelVertices, k->candidates);
+  k->kernel = GraphGetSubgraph(g, kernelVertices);
+
+  IndicesSetDestroy(&kernelVertices);
+  DominationCheckerDestroy(&(r.d));
+  free(r.excluded);
+  free(r.required);
+  free(r.mark);
+
+  return k;
+}
+
+void DominationKernelDestroy(DominationKernel** p) {
+  assert(*p != NULL);
+  DominationKernel* k = *p;
+
+  GraphDestroy(&(k->kernel));
+  IndicesSetDestroy(&(k->forced));
+  IndicesSetDestroy(&(k->required));
+  IndicesSetDestroy(&(k->candidates));
+  free(k);
+
+  *p = NULL;
+}
+
+//
+// BRANCH-AND-BOUND search for a MIN VERTEX DOMINATING SET
+//
+// The search starts with the greedy dominating set as the best one, and
+// runs on the instance left by the reduction rules.
+// Each search node takes the undominated vertex u with the fewest
+// candidate dominators: one of the vertices of N[u] must be in the set.
+// Each of them is tried in turn, by decreasing coverage (number of
+// undominated vertices they dominate), and then excluded from the
+// following branches, so that no set is visited twice.
+// A candidate w is skipped when another candidate dominates all the
+// undominated vertices that w dominates: any solution with w is still
+// a solution with that other candidate instead.
+//
+// Two undominated vertices are linked when they have a common candidate
+// dominator. When the undominated vertices split into groups that are not
+// linked, each group is solved on its own: the cost is the sum, instead
+// of the product, of the costs of the groups.
+//
+// A node is pruned when a lower bound on the number of vertices still
+// needed is not smaller than the best found so far. The lower bound is the
+// largest of
+//  - ceil(undominated / (maxDegree + 1)): no vertex covers more;
+//  - the sum, over the undominated vertices u, of 1 / (the largest
+//    coverage of a candidate dominator of u): a vertex added to the set
+//    can be shared among, at most, that many undominated vertices;
+//  - the size of a packing: undominated vertices whose candidate
+//    dominators are pairwise disjoint, and so need different vertices.
+//
+// The search is split into subproblems (see below), that share the best
+// set found so far: a node is also pruned when the current set plus the
+// lower bound cannot improve on it, whichever subproblem found it.
+//
+// The ANYTIME version stops at a time or node limit: every node visited
+// after that returns at once, as if pruned, and the best set found so far
+// is kept. The improvements are reported as soon as they are complete
+// dominating sets, i.e., not from inside a group.
+//
+
+// Look for sets as good as the best one, to break the ties (see below)
+#ifdef BNB_THREADS
+#define BNB_TIES 1
+#else
+#define BNB_TIES 0
+#endif
+
+// Tolerance for the comparisons of sums of weights
+#define WEIGHT_EPSILON 1e-9
+
+// The best set found so far, shared by the subproblems
+typedef struct {
+  IndicesSet* set;
+  BNB_ATOMIC double cost;    // Its size, or its weight
+  unsigned int numReported;  // Size of the last set reported
+#ifdef BNB_THREADS
+  pthread_mutex_t lock;  // For set and numReported
+#endif
+} _BnBBest;
+
+typedef struct {
+  const Graph* g;
+  const GraphCSR* csr;
+  DominationChecker* d;
+  unsigned int maxClosedDegree;  // Max degree + 1
+  // Vertices that can no longer be added: 1 if excluded by the search,
+  // 2 if by the reduction rules
+  char* excluded;
+  unsigned int* mark;  // Stamps, for the marks of the auxiliary functions
+  unsigned int stamp;
+  IndicesSet* forced;  // Forced by the reduction rules
+  uint32_t* required;  // The vertices to dominate
+  unsigned int numRequired;
+  const double* weights;  // For the MIN WEIGHT search
+  double* residual;       // For its lower bound (valid if marked)
+  double weight;          // Weight of the current set
+  _BnBBest* best;
+  uint32_t* found;  // For the solutions of the subproblems
+  unsigned long numNodes;  // Search nodes, added to InstrCount[2] at the end
+  // For the ANYTIME search
+  _SearchLimits* limits;
+  unsigned int inGroups;  // Depth of nested group searches
+} _BnBSearch;
+
+static int _IsUndominated(const _BnBSearch* s, unsigned int v) {
+  return DominationCheckerGetCount(s->d, v) == 0;
+}
+
+// Number of undominated vertices in N[w]
+static unsigned int _Coverage(const _BnBSearch* s, unsigned int w) {
+  unsigned int coverage = _IsUndominated(s, w);
+  unsigned int degree = GraphCSRGetDegree(s->csr, w);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(s->csr, w);
+  for (unsigned int k = 0; k < degree; k++) {
+    coverage += _IsUndominated(s, adjacents[k]);
+  }
+  return coverage;
+}
+
+// Store in cand the vertices of N[u] that are not excluded
+// Return how many
+static unsigned int _Candidates(const _BnBSearch* s, unsigned int u,
+                                uint32_t* cand) {
+  unsigned int n = 0;
+  if (!s->excluded[u]) cand[n++] = u;
+  unsigned int degree = GraphCSRGetDegree(s->csr, u);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(s->csr, u);
+  for (unsigned int k = 0; k < degree; k++) {
+    if (!s->excluded[adjacents[k]]) cand[n++] = adjacents[k];
+  }
+  return n;
+}
+
+// Sum of the shares of the undominated vertices in U (see above)
+// Return UINT32_MAX if some vertex can no longer be dominated
+static unsigned int _ShareBound(const _BnBSearch* s, const uint32_t* U,
+                                unsigned int n, uint32_t* cand) {
+  double sum = 0.0;
+  for (unsigned int i = 0; i < n; i++) {
+    unsigned int numCand = _Candidates(s, U[i], cand);
+    unsigned int maxCoverage = 0;
+    for (unsigned int k = 0; k < numCand; k++) {
+      unsigned int c = _Coverage(s, cand[k]);
+      if (c > maxCoverage) maxCoverage = c;
+    }
+    if (maxCoverage == 0) return UINT32_MAX;
+    sum += 1.0 / maxCoverage;
+  }
+
+  // Rounding up, with some tolerance for the accumulated errors
+  sum -= 1e-9;
+  unsigned int bound = (unsigned int)sum;
+  return (bound < sum) ? bound + 1 : bound;
+}
+
+// Size of a packing of the undominated vertices in U (see above)
+static unsigned int _PackingBound(_BnBSearch* s, const uint32_t* U,
+                                  unsigned int n, uint32_t* cand) {
+  s->stamp++;
+  unsigned int packing = 0;
+  for (unsigned int i = 0; i < n; i++) {
+    unsigned int numCand = _Candidates(s, U[i], cand);
+
+    // Are all candidate dominators of U[i] still unused?
+    unsigned int k = 0;
+    while (k < numCand && s->mark[cand[k]] != s->stamp) k++;
+    if (k < numCand) continue;
+
+    packing++;
+    for (k = 0; k < numCand; k++) {
+      s->mark[cand[k]] = s->stamp;
+    }
+  }
+  return packing;
+}
+
+static unsigned int _LowerBound(_BnBSearch* s, const uint32_t* U,
+                                unsigned int n, uint32_t* cand) {
+  unsigned int bound = (n + s->maxClosedDegree - 1) / s->maxClosedDegree;
+  unsigned int share = _ShareBound(s, U, n, cand);
+  if (share > bound) bound = share;
+  if (bound == UINT32_MAX) return bound;
+  unsigned int packing = _PackingBound(s, U, n, cand);
+  return (packing > bound) ? packing : bound;
+}
+
+// Does w2 dominate all the undominated vertices dominated by w1?
+static int _IsCoveredBy(_BnBSearch* s, unsigned int w1, unsigned int w2) {
+  s->stamp++;
+  s->mark[w2] = s->stamp;
+  unsigned int degree = GraphCSRGetDegree(s->csr, w2);
+  const uint32_t* adjacents = GraphCSRGetAdjacents(s->csr, w2);
+  for (unsigned int k = 0; k < degree; k++) {
+    s->mark[adjacents[k]] = s->stamp;
+  }
+
+  if (_IsUndominated(s, w1) && s->mark[w1] != s->stamp) {
+    return 0;
+  }
+  degree = GraphCSRGetDegree(s->csr, w1);
+  adjacents = GraphCSRGetAdjacents(s->csr, w1);
+  for (unsigned int k = 0; k < degree; k++) {
+    unsigned int x = adjacents[k];
+    if (_IsUndominated(s, x) && s->mark[x] != s->stamp) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// The candidates to branch on, at a node with undominated vertices U
+// Store them in cand, in the order to be tried, and return how many
+// (cand needs space for 2 * maxClosedDegree elements)
+static unsigned int _Branching(_BnBSearch* s, const uint32_t* U,
+                               unsigned int numU, uint32_t* cand) {
+  // Branching vertex: the undominated vertex with fewest candidates
+  // and, among those, with fewest undominated vertices in N[u]:
+  // the search then advances from the already dominated part
+  unsigned int u = U[0];
+  unsigned int numCand = s->maxClosedDegree + 1;
+  unsigned int uCoverage = 0;
+  for (unsigned int i = 0; i < numU; i++) {
+    unsigned int numC = _Candidates(s, U[i], cand);
+    if (numC > numCand) continue;
+    unsigned int c = _Coverage(s, U[i]);
+    if (numC < numCand || c < uCoverage) {
+      u = U[i];
+      numCand = numC;
+      uCoverage = c;
+      if (numC <= 1) break;
+    }
+  }
+  numCand = _Candidates(s, u, cand);
+
+  // By decreasing coverage (insertion sort: there are few candidates)
+  uint32_t* coverage = cand + s->maxClosedDegree;
+  for (unsigned int i = 0; i < numCand; i++) {
+    unsigned int w = cand[i];
+    unsigned int c = _Coverage(s, w);
+    unsigned int j = i;
+    for (; j > 0 && coverage[j - 1] < c; j--) {
+      cand[j] = cand[j - 1];
+      coverage[j] = coverage[j - 1];
+    }
+    cand[j] = w;
+    coverage[j] = c;
+  }
+
+  // Skip the candidates covered by a previous one (with more coverage,
+  // or the same coverage and the same undominated vertices)
+  unsigned int kept = 0;
+  for (unsigned int i = 0; i < numCand; i++) {
+    int covered = 0;
+    for (unsigned int j = 0; j < kept && !covered; j++) {
+      covered = _IsCoveredBy(s, cand[i], cand[j]);
+    }
+    if (!covered) cand[kept++] = cand[i];
+  }
+  return kept;
+}
+
+// Reorder U into groups of linked vertices (see above)
+// Store in start the first position of each group, and return how many
+// The groups are found by a breadth-first search, using U as the queue
+static unsigned int _Groups(_BnBSearch* s, uint32_t* U, unsigned int n,
+                            unsigned int* start, uint32_t* cand) {
+  // Vertices of U not yet in a group: mark == inU
+  s->stamp++;
+  unsigned int inU = s->stamp;
+  for (unsigned int i = 0; i < n; i++) s->mark[U[i]] = inU;
+  s->stamp++;  // Vertices already in a group: mark == inU + 1
+
+  unsigned int numGroups = 0;
+  unsigned int tail = 0;  // U[0 .. tail - 1] are already in a group
+  for (unsigned int i = 0; i < n; i++) {
+    if (s->mark[U[i]] != inU) continue;
+
+    // A new group, starting at U[i]
+    start[numGroups++] = tail;
+    uint32_t first = U[i];
+    U[i] = U[tail];
+    U[tail++] = first;
+    s->mark[first] = inU + 1;
+
+    for (unsigned int head = start[numGroups - 1]; head < tail; head++) {
+      unsigned int numCand = _Candidates(s, U[head], cand);
+      for (unsigned int k = 0; k < numCand; k++) {
+        unsigned int w = cand[k];
+        unsigned int degree = GraphCSRGetDegree(s->csr, w);
+        const uint32_t* adjacents = GraphCSRGetAdjacents(s->csr, w);
+        for (unsigned int j = 0; j <= degree; j++) {
+          unsigned int x = (j == degree) ? w : adjacents[j];
+          if (s->mark[x] != inU) continue;
+          // Move x to the tail of the queue
+          unsigned int pos = tail;
+          while (U[pos] != x) pos++;
+          U[pos] = U[tail];
+          U[tail++] = x;
+          s->mark[x] = inU + 1;
+        }
+      }
+    }
+  }
+  return numGroups;
+}
+
+// Count a search node on n vertices: its lower bound visits the candidate
+// dominators of each of them, and their adjacents
+// Has the search reached the limits of its options?
+static int _Stop(_BnBSearch* s, unsigned int n) {
+  s->numNodes++;
+  unsigned long closedDegree = s->maxClosedDegree;
+  return _LimitReached(s->limits, 1, n * closedDegree * closedDegree);
+}
+
+// Cost of the current set: its size, or its weight
+static double _Cost(const _BnBSearch* s) {
+  if (s->weights != NULL) return s->weight;
+  return IndicesSetGetNumElems(DominationCheckerGetSet(s->d));
+}
+
+// Can a set of the given cost replace the best one?
+// Looking for ties, one as good as the best one may also replace it
+static int _CanImprove(const _BnBSearch* s, double cost) {
+  double tolerance = (s->weights == NULL) ? 0.5 : WEIGHT_EPSILON;
+  return cost < s->best->cost + (BNB_TIES ? tolerance : -tolerance);
+}
+
+// Is set1 lexicographically smaller than set2, i.e., is the first vertex
+// in which they differ in set1?
+static int _IsLexSmaller(const IndicesSet* set1, const IndicesSet* set2) {
+  IndicesSetIter it1;
+  IndicesSetIter it2;
+  int v1 = IndicesSetIterFirst(&it1, set1);
+  int v2 = IndicesSetIterFirst(&it2, set2);
+  while (v1 == v2 && v1 != -1) {
+    v1 = IndicesSetIterNext(&it1);
+    v2 = IndicesSetIterNext(&it2);
+  }
+  if (v1 == -1 || v2 == -1) return v1 == -1 && v2 != -1;
+  return v1 < v2;
+}
+
+// Offer the current set plus sol[0 .. n - 1], with the given cost, as the
+// best set: it replaces it if better or, looking for ties, if as good and
+// lexicographically smaller
+// Report it, if smaller than the last one reported
+static void _Offer(_BnBSearch* s, const uint32_t* sol, unsigned int n,
+                   double cost) {
+  if (!_CanImprove(s, cost)) return;
+  IndicesSet* set = IndicesSetCreateCopy(DominationCheckerGetSet(s->d));
+  for (unsigned int i = 0; i < n; i++) {
+    IndicesSetAdd(set, sol[i]);
+  }
+
+  _BnBBest* best = s->best;
+  double tolerance = (s->weights == NULL) ? 0.5 : WEIGHT_EPSILON;
+#ifdef BNB_THREADS
+  pthread_mutex_lock(&(best->lock));
+#endif
+  if (cost < best->cost - tolerance ||
+      (BNB_TIES && cost < best->cost + tolerance &&
+       _IsLexSmaller(set, best->set))) {
+    IndicesSet* previous = best->set;
+    best->set = set;
+    best->cost = cost;
+    set = previous;
+
+    const DominatingSetSearchOptions* options = s->limits->options;
+    unsigned int size = IndicesSetGetNumElems(best->set);
+    if (options != NULL && options->onImprovement != NULL &&
+        size < best->numReported) {
+      best->numReported = size;
+      options->onImprovement(best->set, options->data);
+    }
+  }
+#ifdef BNB_THREADS
+  pthread_mutex_unlock(&(best->lock));
+#endif
+  IndicesSetDestroy(&set);
+}
+
+// Search for a set of less than limit vertices that, added to the current
+// set, dominates the vertices in U[0 .. n - 1]
+// If found, it is stored in sol, and its size is returned;
+// otherwise, limit is returned
+static unsigned int _BnB(_BnBSearch* s, const uint32_t* vertices,
+                         unsigned int n, unsigned int limit, uint32_t* sol) {
+  if (_Stop(s, n)) return limit;
+
+  // The vertices still undominated
+  uint32_t* U = malloc((n + 2 * s->maxClosedDegree) * sizeof(uint32_t));
+  if (U == NULL) abort();
+  uint32_t* cand = U + n;  // Auxiliary space for the candidates
+  // The subproblems write their solutions in a scratch buffer, copied to
+  // sol only on success: a failed search may overwrite it
+  uint32_t* found = NULL;
+  unsigned int numU = 0;
+  for (unsigned int i = 0; i < n; i++) {
+    if (_IsUndominated(s, vertices[i])) U[numU++] = vertices[i];
+  }
+
+  unsigned int lowerBound = 0;
+  if (numU > 0 && limit > 0) lowerBound = _LowerBound(s, U, numU, cand);
+  if (numU == 0 || limit == 0 || lowerBound >= limit ||
+      !_CanImprove(s, _Cost(s) + lowerBound)) {
+    free(U);
+    return (numU == 0) ? 0 : limit;
+  }
+  found = malloc(limit * sizeof(uint32_t));
+  if (found == NULL) abort();
+
+  // Independent groups: solve each one in turn
+  unsigned int* start = malloc((numU + 1) * sizeof(unsigned int));
+  if (start == NULL) abort();
+  unsigned int numGroups = _Groups(s, U, numU, start, cand);
+  start[numGroups] = numU;
+
+  if (numGroups > 1) {
+    unsigned int* bound = malloc(numGroups * sizeof(unsigned int));
+    if (bound == NULL) abort();
+    unsigned int sumBounds = 0;
+    for (unsigned int k = 0; k < numGroups; k++) {
+      bound[k] =
+          _LowerBound(s, U + start[k], start[k + 1] - start[k], cand);
+      sumBounds += bound[k];
+    }
+
+    unsigned int total = 0;
+    s->inGroups++;
+    for (unsigned int k = 0; k < numGroups && total < limit; k++) {
+      // The other groups need at least their bounds
+      sumBounds -= bound[k];
+      if (total + sumBounds >= limit) {
+        total = limit;
+        break;
+      }
+      unsigned int groupLimit = limit - total - sumBounds;
+      unsigned int r = _BnB(s, U + start[k], start[k + 1] - start[k],
+                            groupLimit, found + total);
+      total = (r < groupLimit) ? total + r : limit;
+    }
+    s->inGroups--;
+
+    if (total < limit) {
+      memcpy(sol, found, total * sizeof(uint32_t));
+    }
+    free(bound);
+    free(start);
+    free(found);
+    free(U);
+    return (total < limit) ? total : limit;
+  }
+  free(start);
+
+  unsigned int numCand = _Branching(s, U, numU, cand);
+
+  // Branch
+  for (unsigned int i = 0; i < numCand && limit > 1; i++) {
+    unsigned int w = cand[i];
+    DominationCheckerAdd(s->d, w);
+    unsigned int r = _BnB(s, U, numU, limit - 1, found);
+    DominationCheckerRemove(s->d, w);
+    if (r < limit - 1) {
+      // A better solution: w and the vertices found
+      sol[0] = w;
+      memcpy(sol + 1, found, r * sizeof(uint32_t));
+      limit = r + 1;
+      if (s->inGroups == 0) _Offer(s, sol, limit, _Cost(s) + limit);
+    }
+    s->excluded[w] = 1;
+  }
+  for (unsigned int i = 0; i < numCand; i++) {
+    s->excluded[cand[i]] = 0;
+  }
+
+  free(found);
+  free(U);
+  return limit;
+}
+
+//
+// BRANCH-AND-BOUND search for a MIN WEIGHT VERTEX DOMINATING SET
+//
+// The same search as for the MIN VERTEX DOMINATING SET, with the weights:
+//  - the candidates are tried by increasing weight per undominated vertex
+//    they dominate;
+//  - a candidate is skipped when another one, not heavier, dominates all
+//    the undominated vertices it dominates;
+//  - the lower bound gives each undominated vertex u the share
+//    min { weight(w) / coverage(w) : w candidate dominator of u }: no
+//    vertex w gets more than weight(w) from the vertices it dominates,
+//    so the shares are a feasible solution of the dual of the fractional
+//    set cover, and their sum is not larger than the weight still needed.
+// The vertices with weight not above 0 are always added to the set.
+//
+
+// Sum of the shares of the undominated vertices in U (see above)
+// Return DBL_MAX if some vertex can no longer be dominated
+static double _WeightBound(_BnBSearch* s, const uint32_t* U,
+                           unsigned int n, uint32_t* cand) {
+  s->stamp++;
+  double sum = 0.0;
+  for (unsigned int i = 0; i < n; i++) {
+    unsigned int numCand = _Candidates(s, U[i], cand);
+    double share = DBL_MAX;
+    for (unsigned int k = 0; k < numCand; k++) {
+      unsigned int w = cand[k];
+      if (s->mark[w] != s->stamp) {
+        s->mark[w] = s->stamp;
+        s->residual[w] = s->weights[w];
+      }
+      if (s->residual[w] < share) share = s->residual[w];
+    }
+    if (share == DBL_MAX) return DBL_MAX;
+    for (unsigned int k = 0; k < numCand; k++) {
+      s->residual[cand[k]] -= share;
+    }
+    sum += share;
+  }
+  return sum;
+}
+
+// The candidates to branch on, at a node with undominated vertices U
+// Store them in cand, in the order to be tried, and return how many
+static unsigned int _WeightBranching(_BnBSearch* s, const uint32_t* U,
+                                     unsigned int numU, uint32_t* cand) {
+  // Branching vertex: the undominated vertex with fewest candidates
+  unsigned int u = U[0];
+  unsigned int numCand = s->maxClosedDegree + 1;
+  for (unsigned int i = 0; i < numU && numCand > 1; i++) {
+    unsigned int numC = _Candidates(s, U[i], cand);
+    if (numC < numCand) {
+      u = U[i];
+      numCand = numC;
+    }
+  }
+  numCand = _Candidates(s, u, cand);
+
+  // By increasing weight per undominated vertex (insertion sort)
+  double* ratio = malloc((numCand + 1) * sizeof(double));
+  if (ratio == NULL) abort();
+  for (unsigned int i = 0; i < numCand; i++) {
+    unsigned int w = cand[i];
+    double r = s->weights[w] / _Coverage(s, w);
+    unsigned int j = i;
+    for (; j > 0 && ratio[j - 1] > r; j--) {
+      cand[j] = cand[j - 1];
+      ratio[j] = ratio[j - 1];
+    }
+    cand[j] = w;
+    ratio[j] = r;
+  }
+
+  // Skip the candidates covered by a previous one, not heavier
+  unsigned int kept = 0;
+  for (unsigned int i = 0; i < numCand; i++) {
+    int covered = 0;
+    for (unsigned int j = 0; j < kept && !covered; j++) {
+      covered = s->weights[cand[j]] <= s->weights[cand[i]] &&
+                _IsCoveredBy(s, cand[i], cand[j]);
+    }
+    if (!covered) cand[kept++] = cand[i];
+  }
+
+  free(ratio);
+  return kept;
+}
+
+// Search for a set lighter than limit that, added to the current set,
+// dominates the vertices in vertices[0 .. n - 1]
+// If found, its vertices are stored in sol, their number in solSize, and
+// its weight is returned; otherwise, limit is returned
+static double _WeightBnB(_BnBSearch* s, const uint32_t* vertices,
+                         unsigned int n, double limit, uint32_t* sol,
+                         unsigned int* solSize) {
+  if (_Stop(s, n)) return limit;
+
+  // The vertices still undominated
+  uint32_t* U = malloc((n + s->maxClosedDegree) * sizeof(uint32_t));
+  if (U == NULL) abort();
+  uint32_t* cand = U + n;
+  unsigned int numU = 0;
+  for (unsigned int i = 0; i < n; i++) {
+    if (_IsUndominated(s, vertices[i])) U[numU++] = vertices[i];
+  }
+
+  if (numU == 0) {
+    free(U);
+    *solSize = 0;
+    return (limit > 0.0) ? 0.0 : limit;
+  }
+  double lowerBound = _WeightBound(s, U, numU, cand);
+  if (lowerBound >= limit - WEIGHT_EPSILON ||
+      !_CanImprove(s, s->weight + lowerBound)) {
+    free(U);
+    return limit;
+  }
+
+  // Each vertex of a solution dominates some vertex of U
+  uint32_t* found = malloc(numU * sizeof(uint32_t));
+  if (found == NULL) abort();
+  unsigned int foundSize;
+
+  // Independent groups: solve each one in turn
+  unsigned int* start = malloc((numU + 1) * sizeof(unsigned int));
+  if (start == NULL) abort();
+  unsigned int numGroups = _Groups(s, U, numU, start, cand);
+  start[numGroups] = numU;
+
+  if (numGroups > 1) {
+    double* bound = malloc(numGroups * sizeof(double));
+    if (bound == NULL) abort();
+    double sumBounds = 0.0;
+    for (unsigned int k = 0; k < numGroups; k++) {
+      bound[k] =
+          _WeightBound(s, U + start[k], start[k + 1] - start[k], cand);
+      sumBounds += bound[k];
+    }
+
+    double total = 0.0;
+    unsigned int totalSize = 0;
+    s->inGroups++;
+    for (unsigned int k = 0; k < numGroups && total < limit; k++) {
+      // The other groups need at least their bounds
+      sumBounds -= bound[k];
+      double groupLimit = limit - total - sumBounds;
+      double r = _WeightBnB(s, U + start[k], start[k + 1] - start[k],
+                            groupLimit, found + totalSize, &foundSize);
+      if (r < groupLimit) {
+        total += r;
+        totalSize += foundSize;
+      } else {
+        total = limit;
+      }
+    }
+    s->inGroups--;
+
+    if (total < limit) {
+      memcpy(sol, found, totalSize * sizeof(uint32_t));
+      *solSize = totalSize;
+    }
+    free(bound);
+    free(start);
+    free(found);
+    free(U);
+    return (total < limit) ? total : limit;
+  }
+  free(start);
+
+  unsigned int numCand = _WeightBranching(s, U, numU, cand);
+
+  // Branch
+  for (unsigned int i = 0; i < numCand; i++) {
+    unsigned int w = cand[i];
+    double weight = s->weights[w];
+    if (weight < limit) {
+      // Restored as it was: adding and subtracting may round
+      double previous = s->weight;
+      DominationCheckerAdd(s->d, w);
+      s->weight += weight;
+      double r = _WeightBnB(s, U, numU, limit - weight, found, &foundSize);
+      s->weight = previous;
+      DominationCheckerRemove(s->d, w);
+      if (r < limit - weight) {
+        // A better solution: w and the vertices found
+        sol[0] = w;
+        memcpy(sol + 1, found, foundSize * sizeof(uint32_t));
+        *solSize = foundSize + 1;
+        limit = weight + r;
+        if (s->inGroups == 0) _Offer(s, sol, *solSize, s->weight + limit);
+      }
+    }
+    s->excluded[w] = 1;
+  }
+  for (unsigned int i = 0; i < numCand; i++) {
+    s->excluded[cand[i]] = 0;
+  }
+
+  free(found);
+  free(U);
+  return limit;
+}
+
+// A first dominating set, to start with a good upper bound:
+// repeatedly add the vertex with the lowest weight per undominated vertex
+// Return its weight
+static double _WeightGreedy(_BnBSearch* s, IndicesSet* set) {
+  unsigned int numVertices = GraphCSRGetNumVertices(s->csr);
+  const uint32_t* vertices = GraphCSRGetVertices(s->csr);
+
+  double total = 0.0;
+  unsigned int numAdded = 0;
+  uint32_t* added = malloc((numVertices + 1) * sizeof(uint32_t));
+  if (added == NULL) abort();
+  while (DominationCheckerGetNumUndominated(s->d) > 0) {
+    unsigned int best = 0;
+    double bestRatio = DBL_MAX;
+    for (unsigned int i = 0; i < numVertices; i++) {
+      unsigned int w = vertices[i];
+      unsigned int c = _Coverage(s, w);
+      if (c > 0 && s->weights[w] / c < bestRatio) {
+        best = w;
+        bestRatio = s->weights[w] / c;
+      }
+    }
+    DominationCheckerAdd(s->d, best);
+    IndicesSetAdd(set, best);
+    added[numAdded++] = best;
+    total += s->weights[best];
+  }
+
+  for (unsigned int i = 0; i < numAdded; i++) {
+    DominationCheckerRemove(s->d, added[i]);
+  }
+  free(added);
+  return total;
+}
+
+//
+// SUBPROBLEMS of the branch-and-bound searches, and PARALLEL search
+//
+// The top of the search tree is expanded, breadth first, into about
+// BNB_SPLIT_TASKS subproblems: the vertices added and excluded along each
+// path, down to BNB_SPLIT_DEPTH levels. The nodes are expanded as the
+// search does, and the children that cannot improve on the best set are
+// pruned at once. The subproblems are then solved by increasing lower
+// bound, with equal bounds taken by their position in the search tree:
+// the most promising ones first, so that the best sets are found early
+// and the remaining subproblems are pruned.
+//
+// Built with BNB_THREADS, they are solved by a pool of threads, one per
+// processor, each with its own search state. The subproblems are dealt to
+// the threads in turn; each thread takes them from the front of its own
+// queue and, when it is empty, steals them from the back of the others.
+// The best set is shared, and its cost is read atomically by every search
+// node: a better set found by one thread prunes all the others at once.
+//
+// The result must not depend on the timing of the threads: the search
+// then also looks for sets as good as the best one, and keeps the
+// lexicographically smallest of those it finds. A subproblem with a
+// minimum set finds the first one in the search order, whatever the best
+// set is at the time, and the split does not depend on the number of
+// threads: the result is the same for any number and timing of the
+// threads. It is NOT always the lexicographically smallest minimum set:
+// the skipped candidates, and those excluded by the reduction rules,
+// leave some of them out of the search.
+//
+// Without threads, the search is not split: a single subproblem, the
+// whole search, looks only for sets better than the best one, and keeps
+// the first minimum set it finds, not always the one found with threads.
+//
+
+#ifdef BNB_THREADS
+#define BNB_SPLIT_TASKS 64
+#else
+#define BNB_SPLIT_TASKS 1
+#endif
+#define BNB_SPLIT_DEPTH 4
+
+typedef struct {
+  uint32_t* path;  // The vertices added, followed by those excluded
+  unsigned int numAdded;
+  unsigned int numExcluded;
+  double bound;        // Lower bound on the cost of its solutions
+  unsigned int index;  // Position in the search tree
+  int finished;        // Solved, or pruned, before the limits were reached
+} _BnBTask;
+
+typedef struct {
+  _BnBTask* tasks;
+  unsigned int numTasks;
+  unsigned int capacity;
+} _BnBTaskList;
+
+static int _CompareTasks(const void* p1, const void* p2) {
+  const _BnBTask* t1 = p1;
+  const _BnBTask* t2 = p2;
+  if (t1->bound != t2->bound) return (t1->bound < t2->bound) ? -1 : 1;
+  return (t1->index < t2->index) ? -1 : (t1->index > t2->index);
+}
+
+static _BnBTask* _NextTaskSlot(_BnBTaskList* list) {
+  if (list->numTasks == list->capacity) {
+    list->capacity = (list->capacity == 0) ? 16 : 2 * list->capacity;
+    list->tasks = realloc(list->tasks, list->capacity * sizeof(_BnBTask));
+    if (list->tasks == NULL) abort();
+  }
+  return &(list->tasks[list->numTasks++]);
+}
+
+// Append a new subproblem, with space for its path, to the list
+static _BnBTask* _AddTask(_BnBTaskList* list, unsigned int numAdded,
+                          unsigned int numExcluded, double bound) {
+  unsigned int index = list->numTasks;
+  _BnBTask* t = _NextTaskSlot(list);
+  t->path = malloc((numAdded + numExcluded + 1) * sizeof(uint32_t));
+  if (t->path == NULL) abort();
+  t->numAdded = numAdded;
+  t->numExcluded = numExcluded;
+  t->bound = bound;
+  t->index = index;
+  t->finished = 0;
+  return t;
+}
+
+// Weight of the current set, summed in the order of its vertices
+static double _SumWeights(const _BnBSearch* s) {
+  double sum = 0.0;
+  IndicesSetIter it;
+  for (int v = IndicesSetIterFirst(&it, DominationCheckerGetSet(s->d));
+       v != -1; v = IndicesSetIterNext(&it)) {
+    sum += s->weights[v];
+  }
+  return sum;
+}
+
+// Go to the node of the subproblem: add and exclude its vertices
+static void _EnterTask(_BnBSearch* s, const _BnBTask* t) {
+  for (unsigned int i = 0; i < t->numAdded; i++) {
+    DominationCheckerAdd(s->d, t->path[i]);
+  }
+  for (unsigned int i = 0; i < t->numExcluded; i++) {
+    s->excluded[t->path[t->numAdded + i]] = 1;
+  }
+  if (s->weights != NULL) s->weight = _SumWeights(s);
+}
+
+// Go back to the root
+static void _LeaveTask(_BnBSearch* s, const _BnBTask* t) {
+  for (unsigned int i = 0; i < t->numExcluded; i++) {
+    s->excluded[t->path[t->numAdded + i]] = 0;
+  }
+  for (unsigned int i = 0; i < t->numAdded; i++) {
+    DominationCheckerRemove(s->d, t->path[i]);
+  }
+  if (s->weights != NULL) s->weight = _SumWeights(s);
+}
+
+// Store in U the vertices in vertices[0 .. n - 1] still undominated, and
+// their number in numU (U needs space for n + 2 * maxClosedDegree elements)
+// Return a lower bound on the cost of the sets with the current one that
+// dominate them, or DBL_MAX if there are none
+static double _NodeBound(_BnBSearch* s, const uint32_t* vertices,
+                         unsigned int n, uint32_t* U, unsigned int* numU) {
+  *numU = 0;
+  for (unsigned int i = 0; i < n; i++) {
+    if (_IsUndominated(s, vertices[i])) U[(*numU)++] = vertices[i];
+  }
+  if (*numU == 0) return _Cost(s);
+
+  if (s->weights != NULL) {
+    double bound = _WeightBound(s, U, *numU, U + n);
+    return (bound == DBL_MAX) ? DBL_MAX : s->weight + bound;
+  }
+  unsigned int bound = _LowerBound(s, U, *numU, U + n);
+  return (bound == UINT32_MAX) ? DBL_MAX : _Cost(s) + bound;
+}
+
+// Expand the node of the subproblem t, as the search does, into its
+// children, appended to queue; those that cannot improve on the best set
+// are pruned
+// Return 0 if the node is a leaf: all the vertices are dominated
+static int _Expand(_BnBSearch* s, const _BnBTask* t, _BnBTaskList* queue) {
+  unsigned int n = s->numRequired;
+  unsigned int size = n + 2 * s->maxClosedDegree;
+  uint32_t* U = malloc(2 * size * sizeof(uint32_t));
+  if (U == NULL) abort();
+  uint32_t* cand = U + n;
+  uint32_t* V = U + size;  // The vertices still undominated in a child
+
+  _EnterTask(s, t);
+  unsigned int numU;
+  _NodeBound(s, s->required, n, U, &numU);
+  if (numU > 0) {
+    unsigned int numCand = (s->weights == NULL)
+                               ? _Branching(s, U, numU, cand)
+                               : _WeightBranching(s, U, numU, cand);
+    for (unsigned int i = 0; i < numCand; i++) {
+      unsigned int w = cand[i];
+      double previous = s->weight;
+      DominationCheckerAdd(s->d, w);
+      if (s->weights != NULL) s->weight += s->weights[w];
+      unsigned int numV;
+      double bound = _NodeBound(s, U, numU, V, &numV);
+      s->weight = previous;
+      DominationCheckerRemove(s->d, w);
+
+      // The child: w added, and its previous siblings excluded
+      if (_CanImprove(s, bound)) {
+        _BnBTask* child =
+            _AddTask(queue, t->numAdded + 1, t->numExcluded + i, bound);
+        memcpy(child->path, t->path, t->numAdded * sizeof(uint32_t));
+        child->path[t->numAdded] = w;
+        memcpy(child->path + t->numAdded + 1, t->path + t->numAdded,
+               t->numExcluded * sizeof(uint32_t));
+        memcpy(child->path + t->numAdded + 1 + t->numExcluded, cand,
+               i * sizeof(uint32_t));
+      }
+      s->excluded[w] = 1;
+    }
+    for (unsigned int i = 0; i < numCand; i++) {
+      s->excluded[cand[i]] = 0;
+    }
+  }
+  _LeaveTask(s, t);
+
+  free(U);
+  return numU > 0;
+}
+
+// Lower bound on the cost of the sets the whole search could find
+static double _RootBound(_BnBSearch* s) {
+  uint32_t* U =
+      malloc((s->numRequired + 2 * s->maxClosedDegree) * sizeof(uint32_t));
+  if (U == NULL) abort();
+  unsigned int numU;
+  double bound = _NodeBound(s, s->required, s->numRequired, U, &numU);
+  free(U);
+  return bound;
+}
+
+// Split the search into subproblems (see above), stored in list
+// Stopped at the limits of the options, the nodes not yet expanded are
+// stored as they are: the list is still a frontier of the search tree,
+// and its lowest bound is a bound on the sets the search could find
+static void _Split(_BnBSearch* s, _BnBTaskList* list) {
+  _BnBTaskList queue = {NULL, 0, 0};
+  _AddTask(&queue, 0, 0, _RootBound(s));
+
+  unsigned int head = 0;
+  while (head < queue.numTasks &&
+         queue.numTasks - head + list->numTasks < BNB_SPLIT_TASKS) {
+    if (_Stop(s, s->numRequired)) break;
+    _BnBTask t = queue.tasks[head++];  // The queue may be reallocated
+    if (t.numAdded < BNB_SPLIT_DEPTH && _Expand(s, &t, &queue)) {
+      free(t.path);
+    } else {
+      *_NextTaskSlot(list) = t;
+    }
+  }
+  // The ones left in the queue are not expanded
+  while (head < queue.numTasks) {
+    *_NextTaskSlot(list) = queue.tasks[head++];
+  }
+  free(queue.tasks);
+}
+
+// Solve the subproblem: look for a set that improves on the best one
+static void _SolveTask(_BnBSearch* s, const _BnBTask* t) {
+  _EnterTask(s, t);
+  double bestCost = s->best->cost;  // May be changed by another thread
+
+  if (s->weights == NULL) {
+    unsigned int size = IndicesSetGetNumElems(DominationCheckerGetSet(s->d));
+    unsigned int limit = 0;
+    if (bestCost + BNB_TIES > size) {
+      limit = (unsigned int)bestCost + BNB_TIES - size;
+    }
+    unsigned int r = _BnB(s, s->required, s->numRequired, limit, s->found);
+    if (r < limit) _Offer(s, s->found, r, size + r);
+  } else {
+    double limit =
+        bestCost - s->weight + (BNB_TIES ? 2 * WEIGHT_EPSILON : 0.0);
+    unsigned int foundSize;
+    double r = _WeightBnB(s, s->required, s->numRequired, limit, s->found,
+                          &foundSize);
+    if (r < limit) _Offer(s, s->found, foundSize, s->weight + r);
+  }
+
+  _LeaveTask(s, t);
+}
+
+// Solve the subproblem, unless it cannot improve on the best set
+// It is finished, unless the limits of the options were reached
+static void _RunTask(_BnBSearch* s, _BnBTask* t) {
+  if (s->limits->stopped) return;
+  if (_CanImprove(s, t->bound)) _SolveTask(s, t);
+  t->finished = !s->limits->stopped;
+}
+
+#ifdef BNB_THREADS
+
+// One thread per processor, unless set when compiling
+#ifndef BNB_NUM_THREADS
+#define BNB_NUM_THREADS ((unsigned int)sysconf(_SC_NPROCESSORS_ONLN))
+#endif
+
+// The subproblems of a thread: it takes them from the front, and the other
+// threads steal them from the back
+typedef struct {
+  _BnBTask** tasks;
+  unsigned int head;
+  unsigned int tail;
+  pthread_mutex_t lock;
+} _BnBQueue;
+
+typedef struct _BnBWorker {
+  _BnBSearch s;  // Its own search state
+  _BnBQueue queue;
+  struct _BnBWorker* workers;  // All the threads of the pool
+  unsigned int numWorkers;
+  unsigned int id;
+} _BnBWorker;
+
+// A copy of the search state, for another thread: the current set, the
+// exclusions, the marks and the buffers are its own
+static void _CopySearch(const _BnBSearch* s, _BnBSearch* copy) {
+  unsigned int range = GraphCSRGetVertexRange(s->csr);
+  unsigned int numVertices = GraphCSRGetNumVertices(s->csr);
+
+  *copy = *s;
+  copy->d = DominationCheckerCreate(s->g);
+  IndicesSetIter it;
+  for (int v = IndicesSetIterFirst(&it, s->forced); v != -1;
+       v = IndicesSetIterNext(&it)) {
+    DominationCheckerAdd(copy->d, (unsigned int)v);
+  }
+  copy->excluded = malloc(range * sizeof(char));
+  copy->mark = calloc(range, sizeof(unsigned int));
+  copy->stamp = 0;
+  copy->residual = malloc(range * sizeof(double));
+  copy->found = malloc((numVertices + 1) * sizeof(uint32_t));
+  if (copy->excluded == NULL || copy->mark == NULL ||
+      copy->residual == NULL || copy->found == NULL) {
+    abort();
+  }
+  memcpy(copy->excluded, s->excluded, range * sizeof(char));
+  copy->numNodes = 0;
+}
+
+static void _DestroySearchCopy(_BnBSearch* copy) {
+  DominationCheckerDestroy(&(copy->d));
+  free(copy->excluded);
+  free(copy->mark);
+  free(copy->residual);
+  free(copy->found);
+}
+
+// Take a subproblem from the front of the queue, or from its back
+// Return NULL if it is empty
+static _BnBTask* _TakeTask(_BnBQueue* q, int fromBack) {
+  _BnBTask* t = NULL;
+  pthread_mutex_lock(&(q->lock));
+  if (q->head < q->tail) {
+    t = fromBack ? q->tasks[--(q->tail)] : q->tasks[(q->head)++];
+  }
+  pthread_mutex_unlock(&(q->lock));
+  return t;
+}
+
+static void* _Work(void* p) {
+  _BnBWorker* w = p;
+  for (;;) {
+    _BnBTask* t = _TakeTask(&(w->queue), 0);
+    // Its own queue is empty: steal from the others
+    for (unsigned int k = 1; t == NULL && k < w->numWorkers; k++) {
+      t = _TakeTask(&(w->workers[(w->id + k) % w->numWorkers].queue), 1);
+    }
+    if (t == NULL) return NULL;
+    _RunTask(&(w->s), t);
+  }
+}
+
+#endif  // BNB_THREADS
+
+// Solve the subproblems, already sorted (see above)
+static void _SolveTasks(_BnBSearch* s, _BnBTaskList* list) {
+#ifdef BNB_THREADS
+  unsigned int numWorkers = BNB_NUM_THREADS;
+  if (numWorkers > list->numTasks) numWorkers = list->numTasks;
+  if (numWorkers == 0) numWorkers = 1;
+
+  _BnBWorker* workers = malloc(numWorkers * sizeof(_BnBWorker));
+  pthread_t* threads = malloc(numWorkers * sizeof(pthread_t));
+  if (workers == NULL || threads == NULL) abort();
+  for (unsigned int k = 0; k < numWorkers; k++) {
+    _BnBWorker* w = &(workers[k]);
+    _CopySearch(s, &(w->s));
+    w->queue.tasks =
+        malloc((list->numTasks / numWorkers + 1) * sizeof(_BnBTask*));
+    if (w->queue.tasks == NULL) abort();
+    w->queue.head = 0;
+    w->queue.tail = 0;
+    pthread_mutex_init(&(w->queue.lock), NULL);
+    w->workers = workers;
+    w->numWorkers = numWorkers;
+    w->id = k;
+  }
+  for (unsigned int i = 0; i < list->numTasks; i++) {
+    _BnBQueue* q = &(workers[i % numWorkers].queue);
+    q->tasks[(q->tail)++] = &(list->tasks[i]);
+  }
+
+  // The calling thread is the first one of the pool
+  for (unsigned int k = 1; k < numWorkers; k++) {
+    if (pthread_create(&(threads[k]), NULL, _Work, &(workers[k])) != 0) {
+      abort();
+    }
+  }
+  _Work(&(workers[0]));
+  for (unsigned int k = 1; k < numWorkers; k++) {
+    pthread_join(threads[k], NULL);
+  }
+
+  for (unsigned int k = 0; k < numWorkers; k++) {
+    s->numNodes += workers[k].s.numNodes;
+    _DestroySearchCopy(&(workers[k].s));
+    free(workers[k].queue.tasks);
+    pthread_mutex_destroy(&(workers[k].queue.lock));
+  }
+  free(threads);
+  free(workers);
+#else
+  for (unsigned int i = 0; i < list->numTasks; i++) {
+    _RunTask(s, &(list->tasks[i]));
+  }
+#endif
+}
+
+// The search on the graph g or, if k is not NULL, on the kernel graph g
+// of k: its required vertices are dominated with its candidates, and the
+// forced ones are left out (see GraphComputeMinDominatingSetKernel)
+static IndicesSet* _MinDominatingSetBnB(
+    const Graph* g, const DominationKernel* k,
+    const DominatingSetSearchOptions* options, int* isOptimal,
+    unsigned int* lowerBound) {
+  assert(g != NULL);
+  assert(GraphIsDigraph(g) == 0);
+
+  unsigned int range = GraphGetVertexRange(g);
+
+  _SearchLimits limits;
+  limits.options = options;
+  limits.deadline = 0.0;
+  if (options != NULL) limits.deadline = wall_time() + options->timeLimit;
+  limits.numNodes = 0;
+  limits.work = 0;
+  limits.stopped = 0;
+
+  _BnBSearch s;
+  s.g = g;
+  s.limits = &limits;
+  s.inGroups = 0;
+  s.numNodes = 0;
+  s.weights = NULL;
+  s.residual = NULL;
+  s.weight = 0.0;
+  s.csr = GraphFreeze(g);
+  s.d = DominationCheckerCreate(g);
+  s.maxClosedDegree = GraphGetMaxDegree(g) + 1;
+  s.excluded = calloc(range, sizeof(char));
+  s.mark = calloc(range, sizeof(unsigned int));
+  char* required = malloc(range * sizeof(char));
+  if (s.excluded == NULL || s.mark == NULL || required == NULL) abort();
+  memset(required, 1, range);
+  if (k != NULL) {
+    for (unsigned int v = 0; v < range; v++) {
+      required[v] = IndicesSetContains(k->required, v);
+      s.excluded[v] = !IndicesSetContains(k->candidates, v);
+    }
+  }
+
+  // Reduce, and keep the forced vertices in the checker
+  _Reduction r = {s.csr, s.d, s.excluded, required, s.mark, 0, &limits};
+  _Reduce(&r);
+  s.stamp = r.stamp;
+  s.forced = IndicesSetCreateCopy(DominationCheckerGetSet(s.d));
+
+  unsigned int numVertices = GraphCSRGetNumVertices(s.csr);
+  const uint32_t* vertices = GraphCSRGetVertices(s.csr);
+  s.required = malloc((numVertices + 1) * sizeof(uint32_t));
+  s.found = malloc((numVertices + 1) * sizeof(uint32_t));
+  if (s.required == NULL || s.found == NULL) abort();
+  s.numRequired = 0;
+  for (unsigned int i = 0; i < numVertices; i++) {
+    unsigned int v = vertices[i];
+    if (s.excluded[v]) s.excluded[v] = 2;
+    if (required[v]) s.required[s.numRequired++] = v;
+  }
+  free(required);
+
+  // Look for a set smaller than the greedy one or, on a kernel, than all
+  // its candidates: the greedy one may not dominate the vertices left out
+  _BnBBest best;
+  if (k == NULL) {
+    best.set = GraphComputeGreedyDominatingSet(g);
+  } else {
+    best.set = IndicesSetCreateCopy(k->candidates);
+    IndicesSetUnion(best.set, s.forced);
+  }
+  assert(IndicesSetGetNumElems(s.forced) <= IndicesSetGetNumElems(best.set));
+  best.cost = IndicesSetGetNumElems(best.set);
+  best.numReported = IndicesSetGetNumElems(best.set);
+#ifdef BNB_THREADS
+  pthread_mutex_init(&(best.lock), NULL);
+#endif
+  s.best = &best;
+  if (options != NULL && options->onImprovement != NULL) {
+    options->onImprovement(best.set, options->data);
+  }
+
+  _BnBTaskList list = {NULL, 0, 0};
+  double unfinished = DBL_MAX;
+  if (limits.stopped) {
+    // Stopped by the reduction: the rules applied so far are still valid,
+    // and the root of the search bounds the sets it could find
+    unfinished = _RootBound(&s);
+  } else {
+    _Split(&s, &list);
+  }
+  if (!limits.stopped && list.numTasks > 0) {
+    qsort(list.tasks, list.numTasks, sizeof(_BnBTask), _CompareTasks);
+    _SolveTasks(&s, &list);
+  }
+  // The subproblems not finished (all of them, if stopped by the split)
+  // bound the sets they could still find
+  for (unsigned int i = 0; i < list.numTasks; i++) {
+    _BnBTask* t = &(list.tasks[i]);
+    if (!t->finished && t->bound < unfinished) unfinished = t->bound;
+    free(t->path);
+  }
+  unsigned int size = IndicesSetGetNumElems(best.set);
+  if (isOptimal != NULL) *isOptimal = (unfinished >= size);
+  if (lowerBound != NULL) {
+    *lowerBound = (unfinished < size) ? (unsigned int)unfinished : size;
+  }
+  InstrCount[2] += s.numNodes;  // Count search nodes
+
+#ifdef BNB_THREADS
+  pthread_mutex_destroy(&(best.lock));
+#endif
+  DominationCheckerDestroy(&(s.d));
+  IndicesSetDestroy(&(s.forced));
+  free(s.excluded);
+  free(s.mark);
+  free(s.required);
+  free(s.found);
+  free(list.tasks);
+
+  return best.set;
+}
+
+IndicesSet* GraphComputeMinDominatingSetBnB(const Graph* g) {
+  return _MinDominatingSetBnB(g, NULL, NULL, NULL, NULL);
+}
+
+IndicesSet* GraphComputeMinDominatingSetAnytime(
+    const Graph* g, const DominatingSetSearchOptions* options,
+    int* isOptimal, unsigned int* lowerBound) {
+  return _MinDominatingSetBnB(g, NULL, options, isOptimal, lowerBound);
+}
+
+IndicesSet* GraphComputeMinDominatingSetKernel(const DominationKernel* k) {
+  assert(k != NULL);
+
+  IndicesSet* set = _MinDominatingSetBnB(k->kernel, k, NULL, NULL, NULL);
+  IndicesSetUnion(set, k->forced);
+  return set;
+}
+
+IndicesSet* GraphComputeMinWeightDominatingSetBnB(const Graph* g) {
+  assert(g != NULL);
+  assert(GraphIsDigraph(g) == 0);
+
+  unsigned int range = GraphGetVertexRange(g);
+  double* weights = GraphComputeVertexWeights(g);
+  _SearchLimits limits = {NULL, 0.0, 0, 0, 0};  // Not an anytime search
+
+  _BnBSearch s;
+  s.g = g;
+  s.csr = GraphFreeze(g);
+  s.d = DominationCheckerCreate(g);
+  s.maxClosedDegree = GraphGetMaxDegree(g) + 1;
+  s.excluded = calloc(range, sizeof(char));
+  s.mark = calloc(range, sizeof(unsigned int));
+  s.stamp = 0;
+  s.weights = weights;
+  s.residual = malloc(range * sizeof(double));
+  s.limits = &limits;
+  s.inGroups = 0;
+  s.numNodes = 0;
+  if (s.excluded == NULL || s.mark == NULL || s.residual == NULL) abort();
+
+  // The vertices with weight not above 0 are added first
+  unsigned int numVertices = GraphCSRGetNumVertices(s.csr);
+  const uint32_t* vertices = GraphCSRGetVertices(s.csr);
+  for (unsigned int i = 0; i < numVertices; i++) {
+    unsigned int v = vertices[i];
+    if (weights[v] <= 0.0) {
+      DominationCheckerAdd(s.d, v);
+      s.excluded[v] = 2;
+    }
+  }
+  s.forced = IndicesSetCreateCopy(DominationCheckerGetSet(s.d));
+  s.weight = _SumWeights(&s);
+  s.required = malloc((numVertices + 1) * sizeof(uint32_t));
+  s.found = malloc((numVertices + 1) * sizeof(uint32_t));
+  if (s.required == NULL || s.found == NULL) abort();
+  memcpy(s.required, vertices, numVertices * sizeof(uint32_t));
+  s.numRequired = numVertices;
+
+  // Look for a set lighter than the greedy one
+  _BnBBest best;
+  best.set = IndicesSetCreateCopy(s.forced);
+  best.cost = s.weight + _WeightGreedy(&s, best.set);
+  best.numReported = IndicesSetGetNumElems(best.set);
+#ifdef BNB_THREADS
+  pthread_mutex_init(&(best.lock), NULL);
+#endif
+  s.best = &best;
+
+  _BnBTaskList list = {NULL, 0, 0};
+  _Split(&s, &list);
+  if (list.numTasks > 0) {
+    qsort(list.tasks, list.numTasks, sizeof(_BnBTask), _CompareTasks);
+    _SolveTasks(&s, &list);
+  }
+  for (unsigned int i = 0; i < list.numTasks; i++) {
+    free(list.tasks[i].path);
+  }
+  InstrCount[2] += s.numNodes;  // Count search nodes
+
+#ifdef BNB_THREADS
+  pthread_mutex_destroy(&(best.lock));
+#endif
+  DominationCheckerDestroy(&(s.d));
+  IndicesSetDestroy(&(s.forced));
+  free(s.excluded);
+  free(s.mark);
+  free(s.required);
+  free(s.found);
+  free(s.residual);
+  free(list.tasks);
+  free(weights);
+
+  return best.set;
+}
@@ -20,4 +20,71 @@ IndicesSet* GraphComputeMinDominatingSet(const Graph* g);
 
 IndicesSet* GraphComputeMinWeightDominatingSet(const Graph* g);
 
+// Compute a VERTEX DOMINATING SET of the graph, not always a minimum one,
+// using the GREEDY approach: repeatedly add the vertex that dominates
+// most of the vertices still undominated
+// At most ln(maxDegree + 1) + 1 times larger than a minimum one
+// O(V + E) time, for large graphs
+IndicesSet* GraphComputeGreedyDominatingSet(const Graph* g);
+
+// The MIN VERTEX DOMINATING SET problem, reduced by polynomial rules
+// A minimum dominating set of the graph is given by the forced vertices,
+// plus a minimum set of candidates that dominates the required vertices:
+// the kernel alone is NOT an equivalent instance
+typedef struct {
+  Graph* kernel;  // Induced by the required and the candidate vertices
+  IndicesSet* forced;      // Already in the set
+  IndicesSet* required;    // Still to be dominated
+  IndicesSet* candidates;  // Can still be added to the set
+} DominationKernel;
+
+// Reduce the MIN VERTEX DOMINATING SET problem of the graph
+DominationKernel* GraphReduceForDomination(const Graph* g);
+
+void DominationKernelDestroy(DominationKernel** p);
+
+// Compute a MIN VERTEX DOMINATING SET of the reduced graph
+// using the BRANCH-AND-BOUND approach on its kernel
+// Return the forced vertices, plus a minimum set of candidates that
+// dominates the required vertices
+IndicesSet* GraphComputeMinDominatingSetKernel(const DominationKernel* k);
+
+// Compute a MIN VERTEX DOMINATING SET of the graph
+// using a BRANCH-AND-BOUND approach
+// Return the/a dominating set, with the same size as the one found by
+// the exhaustive search, but for much larger graphs
+// Built with BNB_THREADS (make THREADS=1), the search runs on a pool of
+// threads, and returns the same set whatever their number and timing
+// (but not always the set returned without threads)
+IndicesSet* GraphComputeMinDominatingSetBnB(const Graph* g);
+
+// Limits for the ANYTIME version of the branch-and-bound search
+// A zero limit means no limit
+typedef struct {
+  double timeLimit;         // Wall-clock seconds
+  unsigned long nodeLimit;  // Search nodes
+  // If not NULL, called with each dominating set smaller than the
+  // previous ones, starting with the greedy one (built with BNB_THREADS,
+  // from any of the threads, but one call at a time)
+  void (*onImprovement)(const IndicesSet* set, void* data);
+  void* data;  // Passed to onImprovement
+} DominatingSetSearchOptions;
+
+// Compute a MIN VERTEX DOMINATING SET of the graph
+// using a BRANCH-AND-BOUND approach, stopped at the limits of the options
+// (NULL for no limits)
+// Return the smallest dominating set found; if isOptimal is not NULL, it
+// tells whether it is a minimum one; if lowerBound is not NULL, it gets
+// the lower bound proved on the size of the minimum ones
+IndicesSet* GraphComputeMinDominatingSetAnytime(
+    const Graph* g, const DominatingSetSearchOptions* options,
+    int* isOptimal, unsigned int* lowerBound);
+
+// Compute a MIN WEIGHT VERTEX DOMINATING SET of the graph
+// using a BRANCH-AND-BOUND approach
+// Return the/a dominating set, with the same weight as the one found by
+// the exhaustive search, but for much larger graphs
+// Built with BNB_THREADS, as GraphComputeMinDominatingSetBnB
+IndicesSet* GraphComputeMinWeightDominatingSetBnB(const Graph* g);
+
 #endif  // _GRAPH_DOMINATING_SETS_
@@ -19,24 +19,55 @@
 
 #include "instrumentation.h"
 
+// The set is a bitset: element i is bit (i % 64) of word (i / 64).
+// The bits of the last word beyond the range are always 0, so that
+// whole words can be compared, counted and combined.
+#define WORD_BITS 64
+
 struct _IndicesSet {
-  uint16_t range;        // elements in range 0, 1, ... (range - 1)
-  uint16_t num_elems;    // number of stored elements
+  uint32_t range;        // elements in range 0, 1, ... (range - 1)
+  uint32_t num_elems;    // number of stored elements
   int32_t current_elem;  // iterator for the set
-  uint8_t* set;
+  uint32_t num_words;    // number of words of the bitset
+  uint64_t* set;
 };
 
 // LOCAL AUXILIARY FUNCTIONS
 
+static uint32_t _NumWords(uint32_t range) {
+  return (range + WORD_BITS - 1) / WORD_BITS;
+}
+
+// The valid bits of the last word
+static uint64_t _LastWordMask(uint32_t range) {
+  uint32_t r = range % WORD_BITS;
+  return (r == 0) ? ~(uint64_t)0 : (((uint64_t)1 << r) - 1);
+}
+
+static uint32_t _CountElems(const uint64_t* set, uint32_t num_words) {
+  uint32_t count = 0;
+  for (uint32_t k = 0; k < num_words; k++) {
+    count += (uint32_t)__builtin_popcountll(set[k]);
+  }
+  return count;
+}
+
+// The first element >= i, or -1 if there is none
+static int32_t _FindElemFrom(const IndicesSet* p, uint32_t i) {
+  if (i >= p->range) return -1;
+
+  uint32_t k = i / WORD_BITS;
+  uint64_t word = p->set[k] & (~(uint64_t)0 << (i % WORD_BITS));
+  while (word == 0) {
+    if (++k == p->num_words) return -1;
+    word = p->set[k];
+  }
+  return (int32_t)(k * WORD_BITS + (uint32_t)__builtin_ctzll(word));
+}
+
 static void _SetIteratorToFirstElem(IndicesSet* p) {
   if (p->num_elems > 0) {
-    for (uint16_t i = 0; i < p->range; i++) {
-      if (p->set[i] == 1) {
-        p->current_elem = i;  // The first element found
-        break;
-      }
-    }
-
+    p->current_elem = _FindElemFrom(p, 0);  // The first element found
   } else {
     p->current_elem = -1;  // No elements yet
   }
@@ -44,13 +75,14 @@ static void _SetIteratorToFirstElem(IndicesSet* p) {
 
 // Create sets
 
-IndicesSet* IndicesSetCreateEmpty(uint16_t max_size) {
+IndicesSet* IndicesSetCreateEmpty(uint32_t max_size) {
   assert(max_size > 0);
 
   IndicesSet* p = malloc(sizeof(struct _IndicesSet));
   if (p == NULL) abort();
 
-  p->set = calloc(max_size, sizeof(uint8_t));
+  p->num_words = _NumWords(max_size);
+  p->set = calloc(p->num_words, sizeof(uint64_t));
   if (p->set == NULL) abort();
 
   p->range = max_size;
@@ -60,20 +92,14 @@ IndicesSet* IndicesSetCreateEmpty(uint16_t max_size) {
   return p;
 }
 
-IndicesSet* IndicesSetCreateFull(uint16_t max_size) {
+IndicesSet* IndicesSetCreateFull(uint32_t max_size) {
   assert(max_size > 0);
 
-  IndicesSet* p = malloc(sizeof(struct _IndicesSet));
-  if (p == NULL) abort();
-
-  p->set = malloc(max_size * sizeof(uint8_t));
-  if (p->set == NULL) abort();
+  IndicesSet* p = IndicesSetCreateEmpty(max_size);
 
-  for (uint16_t i = 0; i < max_size; i++) {
-    p->set[i] = 1;
-  }
+  memset(p->set, 0xff, p->num_words * sizeof(uint64_t));
+  p->set[p->num_words - 1] = _LastWordMask(max_size);
 
-  p->range = max_size;
   p->num_elems = max_size;
   p->current_elem = 0;  // The first element
 
@@ -89,11 +115,10 @@ IndicesSet* IndicesSetCreateComplement(const IndicesSet* p) {
   }
 
   // Setting the elements of the complementar set
-  for (uint16_t i = 0; i < p->range; i++) {
-    if (p->set[i] == 0) {
-      comp->set[i] = 1;
-    }
+  for (uint32_t k = 0; k < p->num_words; k++) {
+    comp->set[k] = ~p->set[k];
   }
+  comp->set[p->num_words - 1] &= _LastWordMask(p->range);
 
   comp->num_elems = p->range - p->num_elems;
 
@@ -112,7 +137,7 @@ IndicesSet* IndicesSetCreateCopy(const IndicesSet* p) {
 
   // Original set is not empty
 
-  memcpy(copy->set, p->set, p->range);
+  memcpy(copy->set, p->set, p->num_words * sizeof(uint64_t));
 
   copy->num_elems = p->num_elems;
 
@@ -137,39 +162,39 @@ void IndicesSetDestroy(IndicesSet** pp) {
 
 // Operations with individual elements
 
-int IndicesSetContains(const IndicesSet* p, uint16_t v) {
+int IndicesSetContains(const IndicesSet* p, uint32_t v) {
   assert(v < p->range);
 
-  return p->set[v];
+  return (int)((p->set[v / WORD_BITS] >> (v % WORD_BITS)) & 1);
 }
 
-int IndicesSetAdd(IndicesSet* p, uint16_t v) {
+int IndicesSetAdd(IndicesSet* p, uint32_t v) {
   assert(v < p->range);
 
-  if (p->set[v]) {
+  uint64_t bit = (uint64_t)1 << (v % WORD_BITS);
+  if (p->set[v / WORD_BITS] & bit) {
     // Already in set
     return 0;
   }
 
-  p->set[v] = 1;
+  p->set[v / WORD_BITS] |= bit;
 
   p->num_elems++;
 
-  // Reset the set iterator
-  _SetIteratorToFirstElem(p);
+  // The set iterator is not reset: it goes on from its current element
 
   return 1;
 }
 
-int IndicesSetRemove(IndicesSet* p, uint16_t v) {
+int IndicesSetRemove(IndicesSet* p, uint32_t v) {
   assert(v < p->range);
 
-  if (p->set[v]) {
-    p->set[v] = 0;
+  uint64_t bit = (uint64_t)1 << (v % WORD_BITS);
+  if (p->set[v / WORD_BITS] & bit) {
+    p->set[v / WORD_BITS] &= ~bit;
     p->num_elems--;
 
-    // Reset the set iterator
-    _SetIteratorToFirstElem(p);
+    // The set iterator is not reset: it goes on from its current element
 
     return 1;
   }
@@ -180,11 +205,11 @@ int IndicesSetRemove(IndicesSet* p, uint16_t v) {
 
 // Basic properties
 
-uint16_t IndicesSetGetRange(const IndicesSet* p) { return p->range; }
+uint32_t IndicesSetGetRange(const IndicesSet* p) { return p->range; }
 
 int IndicesSetIsEmpty(const IndicesSet* p) { return (p->num_elems == 0); }
 
-uint16_t IndicesSetGetNumElems(const IndicesSet* p) { return p->num_elems; }
+uint32_t IndicesSetGetNumElems(const IndicesSet* p) { return p->num_elems; }
 
 int IndicesSetIsSubset(const IndicesSet* p1, const IndicesSet* p2) {
   assert(p1->range == p2->range);
@@ -193,8 +218,8 @@ int IndicesSetIsSubset(const IndicesSet* p1, const IndicesSet* p2) {
     return 0;
   }
 
-  for (uint16_t i = 0; i < p1->range; i++) {
-    if (p1->set[i] && !p2->set[i]) {
+  for (uint32_t k = 0; k < p1->num_words; k++) {
+    if (p1->set[k] & ~p2->set[k]) {
       return 0;
     }
   }
@@ -209,7 +234,7 @@ int IndicesSetIsEqual(const IndicesSet* p1, const IndicesSet* p2) {
     return 0;
   }
 
-  if (memcmp(p1->set, p2->set, p1->range) == 0) {
+  if (memcmp(p1->set, p2->set, p1->num_words * sizeof(uint64_t)) == 0) {
     return 1;
   }
 
@@ -223,18 +248,14 @@ int IndicesSetIsDifferent(const IndicesSet* p1, const IndicesSet* p2) {
 // Union, intersection and difference operations
 // The first set is updated
 // The second set is untouched
+// Word by word: simple loops, that the compiler can vectorize
 void IndicesSetUnion(IndicesSet* p1, const IndicesSet* p2) {
   assert(p1->range == p2->range);
 
-  for (uint16_t i = 0; i < p1->range; i++) {
-    if (!p1->set[i] && p2->set[i]) {
-      p1->set[i] = 1;
-      p1->num_elems++;
-    }
+  for (uint32_t k = 0; k < p1->num_words; k++) {
+    p1->set[k] |= p2->set[k];
   }
-
-  // Reset the iterator of the first set
-  _SetIteratorToFirstElem(p1);
+  p1->num_elems = _CountElems(p1->set, p1->num_words);
 }
 
 // Union, intersection and difference operations
@@ -243,15 +264,10 @@ void IndicesSetUnion(IndicesSet* p1, const IndicesSet* p2) {
 void IndicesSetIntersection(IndicesSet* p1, const IndicesSet* p2) {
   assert(p1->range == p2->range);
 
-  for (uint16_t i = 0; i < p1->range; i++) {
-    if (p1->set[i] && !p2->set[i]) {
-      p1->set[i] = 0;
-      p1->num_elems--;
-    }
+  for (uint32_t k = 0; k < p1->num_words; k++) {
+    p1->set[k] &= p2->set[k];
   }
-
-  // Reset the iterator of the first set
-  _SetIteratorToFirstElem(p1);
+  p1->num_elems = _CountElems(p1->set, p1->num_words);
 }
 
 // Union, intersection and difference operations
@@ -260,15 +276,10 @@ void IndicesSetIntersection(IndicesSet* p1, const IndicesSet* p2) {
 void IndicesSetDifference(IndicesSet* p1, const IndicesSet* p2) {
   assert(p1->range == p2->range);
 
-  for (uint16_t i = 0; i < p1->range; i++) {
-    if (p1->set[i] && p2->set[i]) {
-      p1->set[i] = 0;
-      p1->num_elems--;
-    }
+  for (uint32_t k = 0; k < p1->num_words; k++) {
+    p1->set[k] &= ~p2->set[k];
   }
-
-  // Reset the iterator of the first set
-  _SetIteratorToFirstElem(p1);
+  p1->num_elems = _CountElems(p1->set, p1->num_words);
 }
 
 // To iterate over the elements of a set
@@ -288,21 +299,29 @@ int IndicesSetGetNextElem(IndicesSet* p) {
   assert(p->num_elems > 0);
 
   // Move to next element, if any
-  uint16_t i = p->current_elem + 1;
-  for (; i < p->range; i++) {
-    if (p->set[i]) {
-      break;
-    }
-  }
+  p->current_elem = _FindElemFrom(p, (uint32_t)(p->current_elem + 1));
 
-  if (i == p->range) {
-    // Past the last element
-    p->current_elem = -1;
-  } else {
-    p->current_elem = i;
+  return p->current_elem;
+}
+
+// External iterators
+
+/// Return the first element in the set OR -1, if the set is empty
+int IndicesSetIterFirst(IndicesSetIter* it, const IndicesSet* p) {
+  it->set = p;
+  it->current = _FindElemFrom(p, 0);
+
+  return it->current;
+}
+
+/// Return the next element in the set OR -1, if past the last
+/// Skips whole empty words: O(1) amortised for each element visited
+int IndicesSetIterNext(IndicesSetIter* it) {
+  if (it->current != -1) {
+    it->current = _FindElemFrom(it->set, (uint32_t)it->current + 1);
   }
 
-  return p->current_elem;
+  return it->current;
 }
 
 // To iterate over all possible subsets of {0, 1, ... , (range - 1)}
@@ -313,24 +332,26 @@ int IndicesSetGetNextElem(IndicesSet* p) {
 // Return 0, if past the last subset (i.e., past the full set)
 // Return 1, otherwise
 int IndicesSetNextSubset(IndicesSet* p) {
-  uint16_t i = 0;
-
-  while ((i < p->range) && (p->set[i] == 1)) {
-    p->set[i] = 0;
-    p->num_elems--;
-    i++;
+  // Add 1 to the binary number, a word at a time
+  uint32_t k = 0;
+  for (; k < p->num_words; k++) {
+    uint64_t old = p->set[k];
+    p->set[k] = old + 1;
+    p->num_elems += (uint32_t)__builtin_popcountll(p->set[k]);
+    p->num_elems -= (uint32_t)__builtin_popcountll(old);
+    if (p->set[k] != 0) break;  // No carry
   }
 
-  if (i < p->range) {
-    p->set[i] = 1;
-    p->num_elems++;
-    _SetIteratorToFirstElem(p);
-    return 1;
+  // The carry went past the range: all bits are now 0
+  if (k == p->num_words ||
+      (p->set[p->num_words - 1] & ~_LastWordMask(p->range)) != 0) {
+    /* Overflow */
+    p->set[p->num_words - 1] = 0;
+    p->num_elems = 0;
+    return 0;
   }
 
-  /* Overflow */
-  _SetIteratorToFirstElem(p);
-  return 0;
+  return 1;
 }
 
 // Help functions
@@ -345,14 +366,13 @@ void IndicesSetDisplay(const IndicesSet* p) {
 
   int first = 1;
   printf("{ ");
-  for (uint16_t i = 0; i < p->range; i++) {
-    if (p->set[i]) {
-      if (first) {
-        printf("%d", (int)i);
-        first = 0;
-      } else {
-        printf(", %d", (int)i);
-      }
+  for (int32_t i = _FindElemFrom(p, 0); i != -1;
+       i = _FindElemFrom(p, (uint32_t)i + 1)) {
+    if (first) {
+      printf("%d", (int)i);
+      first = 0;
+    } else {
+      printf(", %d", (int)i);
     }
   }
   printf(" }\n");
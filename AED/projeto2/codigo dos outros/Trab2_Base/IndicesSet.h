@@ -16,11 +16,13 @@
 
 typedef struct _IndicesSet IndicesSet;
 
+// Sets are stored as bitsets, packed in 64-bit words
+
 // Create and destroy sets
 
-IndicesSet* IndicesSetCreateEmpty(uint16_t range);
+IndicesSet* IndicesSetCreateEmpty(uint32_t range);
 
-IndicesSet* IndicesSetCreateFull(uint16_t range);
+IndicesSet* IndicesSetCreateFull(uint32_t range);
 
 IndicesSet* IndicesSetCreateComplement(const IndicesSet* p);
 
@@ -30,19 +32,19 @@ void IndicesSetDestroy(IndicesSet** pp);
 
 // Operations with individual elements
 
-int IndicesSetContains(const IndicesSet* p, uint16_t v);
+int IndicesSetContains(const IndicesSet* p, uint32_t v);
 
-int IndicesSetAdd(IndicesSet* p, uint16_t v);
+int IndicesSetAdd(IndicesSet* p, uint32_t v);
 
-int IndicesSetRemove(IndicesSet* p, uint16_t v);
+int IndicesSetRemove(IndicesSet* p, uint32_t v);
 
 // Basic properties
 
-uint16_t IndicesSetGetRange(const IndicesSet* p);
+uint32_t IndicesSetGetRange(const IndicesSet* p);
 
 int IndicesSetIsEmpty(const IndicesSet* p);
 
-uint16_t IndicesSetGetNumElems(const IndicesSet* p);
+uint32_t IndicesSetGetNumElems(const IndicesSet* p);
 
 int IndicesSetIsSubset(const IndicesSet* p1, const IndicesSet* p2);
 
@@ -66,6 +68,24 @@ int IndicesSetGetFirstElem(IndicesSet* p);
 
 int IndicesSetGetNextElem(IndicesSet* p);
 
+// External iterators: independent of the set and of each other
+// (e.g., for nested loops), with no allocation.
+// Adding or removing elements does not invalidate an iterator:
+// it goes on from its current element, in increasing order.
+//
+//   IndicesSetIter it;
+//   for (int v = IndicesSetIterFirst(&it, set); v != -1;
+//        v = IndicesSetIterNext(&it)) { ... }
+
+typedef struct {
+  const IndicesSet* set;
+  int32_t current;  // The current element, or -1 if past the last
+} IndicesSetIter;
+
+int IndicesSetIterFirst(IndicesSetIter* it, const IndicesSet* p);
+
+int IndicesSetIterNext(IndicesSetIter* it);
+
 // To iterate over all possible subsets of the range in binary table order
 
 int IndicesSetNextSubset(IndicesSet* p);
@@ -18,6 +18,7 @@
 struct _ListNode {
   void* item;
   struct _ListNode* next;
+  struct _ListNode* prev;  // To remove a node in O(1)
 };
 
 struct _SortedList {
@@ -180,6 +181,20 @@ void ListMoveToHead(List* l) { ListMove(l, 0); }
 
 void ListMoveToTail(List* l) { ListMove(l, l->size - 1); }
 
+// External iterator
+
+void* ListIterFirst(ListIter* it, const List* l) {
+  it->node = l->head;
+  return ListIterNext(it);
+}
+
+void* ListIterNext(ListIter* it) {
+  if (it->node == NULL) return NULL;
+  void* item = it->node->item;
+  it->node = it->node->next;
+  return item;
+}
+
 // You may add extra definitions here.
 
 // INSERT
@@ -189,16 +204,33 @@ void ListMoveToTail(List* l) { ListMove(l, l->size - 1); }
 // return 0 on success
 // return -1 on failure
 int ListInsert(List* l, void* p) {
+  return (ListInsertGetNode(l, p) == NULL) ? -1 : 0;
+}
+
+// Insert a node, and return it
+// return NULL on failure
+ListNode* ListInsertGetNode(List* l, void* p) {
   struct _ListNode* sn = (struct _ListNode*)malloc(sizeof(struct _ListNode));
   if (sn == NULL) abort();
   sn->item = p;
   sn->next = NULL;
+  sn->prev = NULL;
 
   // Empty list
   if (l->size == 0) {
     l->head = l->tail = sn;
     l->size = 1;
-    return 0;
+    return sn;
+  }
+
+  // Inserting in increasing order (e.g., vertices 0, 1, 2, ...)
+  // Append after the tail without scanning the list
+  if (l->compare(p, l->tail->item) > 0) {
+    sn->prev = l->tail;
+    l->tail->next = sn;
+    l->tail = sn;
+    l->size++;
+    return sn;
   }
 
   // Search
@@ -212,26 +244,29 @@ int ListInsert(List* l, void* p) {
   }
 
   if (i == l->size) {  // Append after the tail
+    sn->prev = l->tail;
     l->tail->next = sn;
     l->tail = sn;
     l->size++;
-    return 0;
+    return sn;
   }
 
   if (l->compare(p, aux->item) == 0) {  // Already exists !!
     free(sn);
-    return -1;  // failure
+    return NULL;  // failure
   }
 
   // Append before aux
   sn->next = aux;
+  sn->prev = prev;
+  aux->prev = sn;
   if (i == 0)
     l->head = sn;  // Append at the head
   else
     prev->next = sn;                        // Append after prev
   if (l->currentPos >= i) l->currentPos++;  // Fix currentPos
   l->size++;
-  return 0;
+  return sn;
 }
 
 // Remove functions
@@ -255,6 +290,8 @@ void* ListRemoveHead(List* l) {
   l->head = sn;
   if (l->size == 1) {
     l->tail = NULL;
+  } else {
+    sn->prev = NULL;
   }
   l->size--;
   return item;
@@ -269,13 +306,10 @@ void* ListRemoveTail(List* l) {
     l->currentPos = -1;
   }
   void* item = l->tail->item;
-  struct _ListNode* sn = NULL;
+  struct _ListNode* sn = l->tail->prev;  // node before tail
   if (l->size == 1) {
     l->head = NULL;
   } else {
-    // find sn = node before tail
-    sn = l->head;
-    while (sn->next != l->tail) sn = sn->next;
     sn->next = NULL;
   }
   free(l->tail);
@@ -295,12 +329,12 @@ void* ListRemoveCurrent(List* l) {
   else if (l->currentPos == l->size - 1)
     item = ListRemoveTail(l);
   else {
-    // find node before current, change its next field,
+    // link the nodes before and after current,
     // free current, change current, change size
 
-    struct _ListNode* sn = l->head;
-    while (sn->next != l->current) sn = sn->next;
+    struct _ListNode* sn = l->current->prev;
     sn->next = l->current->next;
+    sn->next->prev = sn;
     free(l->current);
     l->current = sn->next;
     l->size--;
@@ -308,6 +342,28 @@ void* ListRemoveCurrent(List* l) {
   return item;
 }
 
+// REMOVE a given node
+
+// Remove the node and return its item, in O(1)
+// The current node is moved outside, as its position may change
+void* ListRemoveNode(List* l, ListNode* node) {
+  assert(l->size > 0);
+  void* item = node->item;
+  if (node->prev == NULL)
+    l->head = node->next;
+  else
+    node->prev->next = node->next;
+  if (node->next == NULL)
+    l->tail = node->prev;
+  else
+    node->next->prev = node->prev;
+  free(node);
+  l->current = NULL;
+  l->currentPos = -1;
+  l->size--;
+  return item;
+}
+
 // Tests
 
 void ListTestInvariants(const List* l) {
@@ -323,10 +379,11 @@ void ListTestInvariants(const List* l) {
   assert((l->currentPos == -1) == (l->current == NULL));
   struct _ListNode* sn = l->head;
   for (int i = 0; i < l->size; i++) {
+    if (i == 0) assert(sn->prev == NULL);
     if (i == l->size - 1)
       assert(sn == l->tail && sn->next == NULL);
     else
-      assert(sn->next != NULL);
+      assert(sn->next != NULL && sn->next->prev == sn);
     if (i == l->currentPos) assert(sn == l->current);
     sn = sn->next;
   }
@@ -12,6 +12,7 @@
 #define _SORTED_LIST_
 
 typedef struct _SortedList List;
+typedef struct _ListNode ListNode;
 typedef int (*compFunc)(const void* p1, const void* p2);
 
 List* ListCreate(compFunc compF);
@@ -46,6 +47,22 @@ void ListMoveToHead(List* l);
 
 void ListMoveToTail(List* l);
 
+// External iterator
+// Does not change the current node, so iterations may be nested
+// The list must not be modified during the iteration
+//   ListIter it;
+//   for (void* p = ListIterFirst(&it, l); p != NULL; p = ListIterNext(&it)) {
+//     ...
+//   }
+
+typedef struct {
+  const struct _ListNode* node;  // The next node, or NULL if past the tail
+} ListIter;
+
+void* ListIterFirst(ListIter* it, const List* l);
+
+void* ListIterNext(ListIter* it);
+
 // Search
 // The search function returns 0 on success and -1 on failure.
 // On success the current node is changed, on failure it is not changed.
@@ -55,6 +72,10 @@ int ListSearch(List* l, const void* p);
 
 int ListInsert(List* l, void* p);
 
+// Insert, and return the new node (NULL on failure): it is valid until it
+// is removed, and ListRemoveNode removes it in O(1)
+ListNode* ListInsertGetNode(List* l, void* p);
+
 // Remove
 
 void* ListRemoveHead(List* l);
@@ -63,6 +84,10 @@ void* ListRemoveTail(List* l);
 
 void* ListRemoveCurrent(List* l);
 
+// Remove the node, and return its item
+// The current node is moved outside
+void* ListRemoveNode(List* l, ListNode* node);
+
 // Tests
 
 void ListTestInvariants(const List* l);
@@ -10,6 +10,8 @@
 
 #include <assert.h>
 
+#include "DominatingSetMaintainer.h"
+#include "DominationChecker.h"
 #include "Graph.h"
 #include "GraphDominatingSets.h"
 #include "IndicesSet.h"
@@ -44,6 +46,21 @@ int main(void) {
   IndicesSetDestroy(&test_set);
   printf("\n");
 
+  // The same test, incrementally, with a domination checker
+  DominationChecker* checker = DominationCheckerCreate(g02);
+  DominationCheckerAdd(checker, 0);
+  DominationCheckerAdd(checker, 1);
+  printf("Undominated vertices = %u\n",
+         DominationCheckerGetNumUndominated(checker));
+  DominationCheckerRemove(checker, 0);
+  DominationCheckerAdd(checker, 6);
+  DominationCheckerAdd(checker, 8);
+  DominationCheckerAdd(checker, 11);
+  printf("{ 1, 6, 8, 11 } is a dominating set? %d\n",
+         DominationCheckerIsDominating(checker));
+  DominationCheckerDestroy(&checker);
+  printf("\n");
+
   printf("Finding a MIN dominating set\n");
   IndicesSet* mdset = GraphComputeMinDominatingSet(g02);
   IndicesSetDisplay(mdset);
@@ -58,6 +75,31 @@ int main(void) {
   GraphDestroy(&mdset_graph);
   printf("\n");
 
+  printf("Finding a dominating set by the GREEDY heuristic\n");
+  IndicesSet* gdset = GraphComputeGreedyDominatingSet(g02);
+  IndicesSetDisplay(gdset);
+  printf("Is it a dominating set? %d\n", GraphIsDominatingSet(g02, gdset));
+  IndicesSetDestroy(&gdset);
+  printf("\n");
+
+  printf("Finding a MIN dominating set by branch-and-bound\n");
+  mdset = GraphComputeMinDominatingSetBnB(g02);
+  IndicesSetDisplay(mdset);
+  printf("Is it a dominating set? %d\n", GraphIsDominatingSet(g02, mdset));
+  IndicesSetDestroy(&mdset);
+  printf("\n");
+
+  printf("The same search, stopped after 3 nodes\n");
+  DominatingSetSearchOptions options = {0.0, 3, NULL, NULL};
+  int isOptimal;
+  unsigned int lowerBound;
+  mdset = GraphComputeMinDominatingSetAnytime(g02, &options, &isOptimal,
+                                              &lowerBound);
+  IndicesSetDisplay(mdset);
+  printf("Is it optimal? %d (lower bound = %u)\n", isOptimal, lowerBound);
+  IndicesSetDestroy(&mdset);
+  printf("\n");
+
   printf("Finding a MIN WEIGHT dominating set\n");
   IndicesSet* mwdset = GraphComputeMinWeightDominatingSet(g02);
   IndicesSetDisplay(mwdset);
@@ -67,6 +109,74 @@ int main(void) {
   IndicesSetDestroy(&mwdset);
   GraphDestroy(&mwdset_graph);
   printf("\n");
+
+  printf("Finding a MIN WEIGHT dominating set by branch-and-bound\n");
+  mwdset = GraphComputeMinWeightDominatingSetBnB(g02);
+  IndicesSetDisplay(mwdset);
+  printf("Is it a dominating set? %d\n", GraphIsDominatingSet(g02, mwdset));
+  IndicesSetDestroy(&mwdset);
+  printf("\n");
+  printf("Maintaining a dominating set of a copy of the graph\n");
+  IndicesSet* all_vertices = GraphGetSetVertices(g02);
+  Graph* g02_copy = GraphGetSubgraph(g02, all_vertices);
+  IndicesSetDestroy(&all_vertices);
+  mdset = GraphComputeMinDominatingSetBnB(g02_copy);
+  DominatingSetMaintainer* maintainer =
+      DominatingSetMaintainerCreate(g02_copy, mdset);
+  IndicesSetDestroy(&mdset);
+  DominatingSetMaintainerRemoveVertex(maintainer, 1);
+  DominatingSetMaintainerRemoveEdge(maintainer, 9, 10);
+  DominatingSetMaintainerAddEdge(maintainer, 0, 14);
+  IndicesSet* maintained =
+      IndicesSetCreateCopy(DominatingSetMaintainerGetSet(maintainer));
+  IndicesSetDisplay(maintained);
+  printf("Is it a dominating set? %d\n",
+         GraphIsDominatingSet(g02_copy, maintained));
+  IndicesSetDestroy(&maintained);
+  DominatingSetMaintainerRecompute(maintainer,
+                                   GraphComputeMinDominatingSetBnB);
+  printf("Recomputed: ");
+  IndicesSetDisplay(DominatingSetMaintainerGetSet(maintainer));
+  DominatingSetMaintainerDestroy(&maintainer);
+  GraphDestroy(&g02_copy);
+  printf("\n");
+
+  // A graph for the reduction rules: a 9-cycle, which none of them
+  // reduces, a pendant vertex 9, and the twins 12 and 13
+  Graph* g04 = GraphCreate(14, 0, 0);
+  for (unsigned int v = 0; v < 9; v++) {
+    GraphAddEdge(g04, v, (v + 1) % 9);
+  }
+  GraphAddEdge(g04, 9, 10);
+  GraphAddEdge(g04, 10, 11);
+  GraphAddEdge(g04, 11, 12);
+  GraphAddEdge(g04, 11, 13);
+  GraphAddEdge(g04, 12, 13);
+
+  printf("Reducing the MIN dominating set problem\n");
+  DominationKernel* kernel = GraphReduceForDomination(g04);
+  printf("Forced vertices\n");
+  IndicesSetDisplay(kernel->forced);
+  printf("Required vertices\n");
+  IndicesSetDisplay(kernel->required);
+  printf("Candidate vertices\n");
+  IndicesSetDisplay(kernel->candidates);
+  printf("The forced vertices, plus a MIN set of candidates dominating the "
+         "required ones\n");
+  mdset = GraphComputeMinDominatingSetKernel(kernel);
+  IndicesSetDisplay(mdset);
+  IndicesSet* exhaustive = GraphComputeMinDominatingSet(g04);
+  printf("Is it a dominating set? %d Same size as the exhaustive search? %d\n",
+         GraphIsDominatingSet(g04, mdset),
+         IndicesSetGetNumElems(mdset) == IndicesSetGetNumElems(exhaustive));
+  assert(GraphIsDominatingSet(g04, mdset));
+  assert(IndicesSetGetNumElems(mdset) == IndicesSetGetNumElems(exhaustive));
+  IndicesSetDestroy(&exhaustive);
+  IndicesSetDestroy(&mdset);
+  DominationKernelDestroy(&kernel);
+  GraphDestroy(&g04);
+  printf("\n");
+
   // Creating another graph
 
   Graph* g03 = GraphCreateEmpty(4, 0, 0);
@@ -80,6 +80,18 @@ int main(void) {
   printf("\n");
   free(weights_g03);
 
+  // The frozen (CSR) snapshot of g03
+  const GraphCSR* csr_g03 = GraphFreeze(g03);
+  for (unsigned int i = 0; i < GraphCSRGetVertexRange(csr_g03); i++) {
+    const uint32_t* adjacents = GraphCSRGetAdjacents(csr_g03, i);
+    printf("Vertex %u :", i);
+    for (unsigned int k = 0; k < GraphCSRGetDegree(csr_g03, i); k++) {
+      printf(" %u", adjacents[k]);
+    }
+    printf("\n");
+  }
+  printf("\n");
+
   // A subgraph of g03
   IndicesSet* vertices = IndicesSetCreateEmpty(4);
   IndicesSetAdd(vertices, 0);
@@ -111,6 +123,27 @@ int main(void) {
 
   GraphCheckInvariants(subg032);
 
+  // Its connected components
+  unsigned int numComponents;
+  IndicesSet** components =
+      GraphGetConnectedComponents(subg032, &numComponents);
+  printf("Number of connected components = %u\n", numComponents);
+  for (unsigned int i = 0; i < numComponents; i++) {
+    IndicesSetDisplay(components[i]);
+    IndicesSetDestroy(&components[i]);
+  }
+  free(components);
+  printf("\n");
+
+  // Removing an edge and a vertex of subg031
+  printf("Removing edge (0,2) and vertex 3\n");
+  GraphRemoveEdge(subg031, 0, 2);
+  GraphRemoveVertex(subg031, 3);
+  GraphDisplayDOT(subg031);
+  printf("\n");
+
+  GraphCheckInvariants(subg031);
+
   // Reading a directed graph from file
   file = fopen("DG_2.txt", "r");
   Graph* g04 = GraphFromFile(file);
@@ -136,6 +169,25 @@ int main(void) {
   GraphDisplayDOT(subg041);
   printf("\n");
 
+  // Removing a vertex of g04, with its edges in both directions
+  GraphRemoveVertex(g04, 5);
+  printf("Without vertex 5: %u vertices, %u edges\n", GraphGetNumVertices(g04),
+         GraphGetNumEdges(g04));
+  printf("\n");
+
+  GraphCheckInvariants(g04);
+
+  // A complete graph, without one of its vertices, is still complete
+  Graph* g05 = GraphCreateComplete(5, 0);
+  GraphRemoveVertex(g05, 2);
+  printf("K5 without vertex 2: complete? %d contains 2? %d contains 3? %d\n",
+         GraphIsComplete(g05), GraphContainsVertex(g05, 2),
+         GraphContainsVertex(g05, 3));
+  assert(GraphIsComplete(g05));
+  printf("\n");
+
+  GraphCheckInvariants(g05);
+
   // Clearing
   GraphDestroy(&g01);
   GraphDestroy(&g02);
@@ -144,6 +196,7 @@ int main(void) {
   GraphDestroy(&subg032);
   GraphDestroy(&g04);
   GraphDestroy(&subg041);
+  GraphDestroy(&g05);
 
   return 0;
 }
@@ -151,6 +151,34 @@ int main(void) {
   }
   printf("\n");
 
+  // External iterators: nested loops over the same set
+  IndicesSetDisplay(small_set);
+  printf("All pairs of elements of the set\n");
+  IndicesSetIter it1;
+  IndicesSetIter it2;
+  for (int e1 = IndicesSetIterFirst(&it1, small_set); e1 != -1;
+       e1 = IndicesSetIterNext(&it1)) {
+    for (int e2 = IndicesSetIterFirst(&it2, small_set); e2 != -1;
+         e2 = IndicesSetIterNext(&it2)) {
+      if (e1 < e2) {
+        printf("(%d, %d) ", e1, e2);
+      }
+    }
+  }
+  printf("\n");
+
+  // Removing the current element while iterating
+  printf("Removing the elements while walking through the set\n");
+  IndicesSet* copy_set = IndicesSetCreateCopy(another_set);
+  for (int e1 = IndicesSetIterFirst(&it1, copy_set); e1 != -1;
+       e1 = IndicesSetIterNext(&it1)) {
+    printf("%d ", e1);
+    IndicesSetRemove(copy_set, (uint32_t)e1);
+  }
+  printf("\n");
+  assert(IndicesSetIsEmpty(copy_set));
+  IndicesSetDestroy(&copy_set);
+
   // Walking through all subsets of a set of n integers {0, 1, ..., (n - 1)}
 
   printf("\n");
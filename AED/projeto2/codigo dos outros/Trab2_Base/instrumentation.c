@@ -44,6 +44,14 @@ double cpu_time(void) {
   return (double)current_time.tv_sec + 1.0e-9 * (double)current_time.tv_nsec;
 }
 
+double wall_time(void) {
+  struct timespec current_time;
+
+  if (clock_gettime(CLOCK_MONOTONIC, &current_time) != 0)
+    return -1.0; // clock_gettime() failed!!!
+  return (double)current_time.tv_sec + 1.0e-9 * (double)current_time.tv_nsec;
+}
+
 #endif
 
 
@@ -68,6 +76,9 @@ double cpu_time(void) {
   return (double)current_time.QuadPart / (double)frequency.QuadPart;
 }
 
+// The performance counter already measures elapsed time
+double wall_time(void) { return cpu_time(); }
+
 #endif
 
 /// Array of operation counters:
@@ -25,6 +25,9 @@
 /// Cpu time in seconds
 double cpu_time(void) ; ///
 
+/// Wall-clock time in seconds, from an arbitrary origin
+double wall_time(void) ; ///
+
 /// Name of file where InstrCTU is stored
 #define CTUFILE "instrCTU"
 